@@ -2,8 +2,11 @@ import torch
 from torch.utils.data import Dataset
 import json
 import os
+import struct
+import bisect
+import numpy as np
 from PIL import Image
-from utils import ImageTransform
+from utils import ImageTransform, convert_image
 
 
 class SRDataset(Dataset):
@@ -40,7 +43,7 @@ class SRDataset(Dataset):
                 self.images = json.load(file)
         else:
             with open(os.path.join(data_dir, "test_images.json"), "r") as file:
-                self.images = json.laod(file)
+                self.images = json.load(file)
         
         # Select the correct set of transforms
         self.transform = ImageTransform(split=self.split,
@@ -59,10 +62,15 @@ class SRDataset(Dataset):
             the 'i'th pair LR and HR images to be fed into the model
         """
 
-        # Read image
-        img = Image.open(self.images[i], mode="r")
-        img = img.convert("RGB")
-        lr_img, hr_img = self.transform(img)
+        # Read image; entries written by the renderer's dataset generator pair a HR render with a true LR render
+        if isinstance(self.images[i], dict):
+            img = Image.open(self.images[i]["hr"], mode="r").convert("RGB")
+            lr_img = Image.open(self.images[i]["lr"], mode="r").convert("RGB")
+            lr_img, hr_img = self.transform(img, lr_img)
+        else:
+            img = Image.open(self.images[i], mode="r")
+            img = img.convert("RGB")
+            lr_img, hr_img = self.transform(img)
 
         return lr_img, hr_img
     
@@ -77,3 +85,109 @@ class SRDataset(Dataset):
         return len(self.images)
     
 
+
+class ShardDataset(Dataset):
+    """
+    A PyTorch Dataset over the packed crop shards written by the renderer (Raytracing --generate-dataset ... --crop).
+    Every record is a fixed-size HR crop followed by its LR crop, stored planar as uint8 or float16, so samples are
+    sliced straight out of memory-mapped files without decoding.
+    """
+
+    header_size = 64
+
+    def __init__(self, data_dir, split, lr_img_type, hr_img_type):
+        """
+        Args:
+            data_dir: folder with JSON data files
+            split: name of the split; shards are listed in '<split>_shards.json'
+            lr_img_type: the format for the LR image supplied to the model; see convert_image() in utils.py for available formats
+            hr_img_type: the format for the HR image supplied to the model; see convert_image() in utils.py for available formats
+        """
+
+        self.lr_img_type = lr_img_type
+        self.hr_img_type = hr_img_type
+
+        assert lr_img_type in {'[0, 255]', '[0, 1]', '[-1, 1]', 'imagenet-norm'}
+        assert hr_img_type in {'[0, 255]', '[0, 1]', '[-1, 1]', 'imagenet-norm'}
+
+        with open(os.path.join(data_dir, f"{split.lower()}_shards.json"), "r") as file:
+            self.shards = json.load(file)
+
+        # Read every header; the shards are only mapped once a worker needs them
+        self.counts = list()
+        for path in self.shards:
+            with open(path, "rb") as file:
+                magic, version, fmt, channels, crop_size, scaling_factor, count = struct.unpack("<4s5IQ", file.read(32))
+
+            assert magic == b"SRSH" and version == 1, f"{path} is not a dataset shard!"
+            self.dtype = np.uint8 if fmt == 0 else np.float16
+            self.channels = channels
+            self.crop_size = crop_size
+            self.scaling_factor = scaling_factor
+            self.counts.append(count)
+
+        self.lr_size = self.crop_size // self.scaling_factor
+        self.hr_elements = self.channels * self.crop_size * self.crop_size
+        self.record_elements = self.hr_elements + self.channels * self.lr_size * self.lr_size
+        self.starts = [sum(self.counts[:k]) for k in range(len(self.counts))]
+        self.maps = [None] * len(self.shards)
+
+    def __getitem__(self, i):
+        """
+        This method is required to be defined for use in the PyTorch DataLoader.
+
+        Args:
+            i: index to retrieve
+        Returns:
+            the 'i'th pair LR and HR images to be fed into the model
+        """
+
+        # Find the shard holding this record
+        shard = bisect.bisect_right(self.starts, i) - 1
+        i -= self.starts[shard]
+
+        if self.maps[shard] is None:
+            self.maps[shard] = np.memmap(self.shards[shard], dtype=self.dtype, mode="r", offset=self.header_size,
+                                         shape=(self.counts[shard], self.record_elements))
+
+        record = torch.from_numpy(np.array(self.maps[shard][i]))
+        hr_img = record[:self.hr_elements].view(self.channels, self.crop_size, self.crop_size).float()
+        lr_img = record[self.hr_elements:].view(self.channels, self.lr_size, self.lr_size).float()
+
+        # Bytes hold [0, 255], halves hold [0, 1]
+        if self.dtype == np.uint8:
+            hr_img, lr_img = hr_img / 255.0, lr_img / 255.0
+
+        lr_img = convert_image(lr_img, source="[0, 1]", target=self.lr_img_type)
+        hr_img = convert_image(hr_img, source="[0, 1]", target=self.hr_img_type)
+
+        return lr_img, hr_img
+
+    def __len__(self):
+        """
+        This method is required to be defined for use in the PyTorch DataLoader.
+
+        Returns:
+            size of this data (in number of crops)
+        """
+
+        return sum(self.counts)
+
+
+def read_gbuffer(path):
+    """
+    Reads the auxiliary planes written next to a low res image by the renderer's dataset generator.
+
+    Returns:
+        dict with float32 "depth" (H, W), "normal" (3, H, W), "albedo" (3, H, W), "motion" (2, H, W) and uint32
+        "object_id", "material_id" (H, W) arrays. Pixels that hit nothing have depth 0 and id 0. Motion is the offset
+        in pixels from each pixel to where its surface was on the previous frame, zero for the generated stills
+    """
+    with open(path, "rb") as file:
+        magic, version, width, height = struct.unpack("<4s3I", file.read(16))
+        assert magic == b"SRGB" and version == 2, "Not a G-buffer file: " + path
+        floats = np.fromfile(file, dtype=np.float32, count=9 * width * height).reshape(9, height, width)
+        ids = np.fromfile(file, dtype=np.uint32, count=2 * width * height).reshape(2, height, width)
+
+    return {"depth": floats[0], "normal": floats[1:4], "albedo": floats[4:7], "motion": floats[7:9],
+            "object_id": ids[0], "material_id": ids[1]}
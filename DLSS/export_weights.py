@@ -0,0 +1,51 @@
+import struct
+import torch
+from models import SRResNet, Generator
+
+
+# Export parameters
+model_path = "./models/SRResNetx2.pth"      # full model saved with torch.save(model), or a training checkpoint
+out_path = "./models/SRResNetx2.bin"        # weights file read by the C++ upscaler (Upscaling/NetworkWeights.cpp)
+
+
+def export_weights(model_path: str, out_path: str):
+    """
+    Export the parameters of a SRResNet (or SRGAN generator) to the raw format read by the C++ upscaler.
+
+    The file starts with the magic "SRWT", a version and the number of tensors. Every tensor follows as its
+    name, its number of dimensions, its dimensions and its float32 data, all little endian.
+
+    Args:
+        model_path: path of the model or checkpoint to export
+        out_path: path of the weights file to write
+    """
+
+    model = torch.load(model_path, map_location="cpu")
+
+    # Checkpoints store the model under a key
+    if isinstance(model, dict):
+        model = model["model"] if "model" in model else model["generator"]
+
+    # The generator wraps a SRResNet, whose parameter names the C++ side expects
+    if isinstance(model, Generator):
+        model = model.net
+
+    assert isinstance(model, SRResNet), "Only SRResNet models can be exported!"
+
+    state = {name: tensor for name, tensor in model.state_dict().items() if tensor.is_floating_point()}
+
+    with open(out_path, "wb") as out_file:
+        out_file.write(b"SRWT")
+        out_file.write(struct.pack("<II", 1, len(state)))
+
+        for name, tensor in state.items():
+            encoded = name.encode("utf-8")
+            out_file.write(struct.pack("<I", len(encoded)))
+            out_file.write(encoded)
+            out_file.write(struct.pack("<I", tensor.dim()))
+            out_file.write(struct.pack(f"<{tensor.dim()}I", *tensor.shape))
+            out_file.write(tensor.detach().float().contiguous().numpy().astype("<f4").tobytes())
+
+
+if __name__ == "__main__":
+    export_weights(model_path, out_path)
@@ -3,7 +3,7 @@ import torch.backends.cudnn as cudnn
 import torch
 from torch import nn
 from models import SRResNet
-from dataset import SRDataset
+from dataset import SRDataset, ShardDataset
 from utils import *
 
 
@@ -11,6 +11,7 @@ from utils import *
 data_dir = "./data/COCO/" # folder with JSON data files
 crop_size = 96          # crop size of target HR images
 scaling_factor = 4      # the scaling factor for the generator; the input LR images will be downsampled from the target HR images by this factor
+use_shards = False      # read the packed crops written by the renderer ('<split>_shards.json') instead of decoding images
 
 # Model parameters
 large_kernel_size = 9   # kernel size of the first and last convolutions which transform the inputs and outputs
@@ -66,12 +67,18 @@ def main():
     criterion = nn.MSELoss().to(device)
 
     # Custom dataloaders
-    train_dataset = SRDataset(data_dir,
-                              split="train",
-                              crop_size=crop_size,
-                              scaling_factor=scaling_factor,
-                              lr_img_type="imagenet-norm",
-                              hr_img_type="[-1, 1]")
+    if use_shards:
+        train_dataset = ShardDataset(data_dir,
+                                     split="train",
+                                     lr_img_type="imagenet-norm",
+                                     hr_img_type="[-1, 1]")
+    else:
+        train_dataset = SRDataset(data_dir,
+                                  split="train",
+                                  crop_size=crop_size,
+                                  scaling_factor=scaling_factor,
+                                  lr_img_type="imagenet-norm",
+                                  hr_img_type="[-1, 1]")
     train_loader = torch.utils.data.DataLoader(train_dataset, batch_size=batch_size, shuffle=True, num_workers=workers, pin_memory=True)
 
     # Total number of epochs to train for
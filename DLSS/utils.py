@@ -116,10 +116,11 @@ class ImageTransform(object):
 
         assert self.split in {"train", "test"}
 
-    def __call__(self, img):
+    def __call__(self, img, lr_img=None):
         """
         Args:
             img: a PIL source image from which the HR image will be cropped, and then downsampled to create the LR image
+            lr_img: optional PIL image rendered at 1/scaling_factor of img's size; if given, it is cropped alongside the HR image instead of downsampling it
         Returns:
             LR and HR images in the specified format
         """
@@ -127,8 +128,13 @@ class ImageTransform(object):
         # Crop
         if self.split == "train":
             # take a random fixed-size crop of the image, which will serve as the high resolution (HR) image
-            left = random.randint(1, img.width - self.crop_size)
-            top = random.randint(1, img.height - self.crop_size)
+            if lr_img is None:
+                left = random.randint(1, img.width - self.crop_size)
+                top = random.randint(1, img.height - self.crop_size)
+            else:
+                # keep the crop on the LR pixel grid so both crops cover the same area
+                left = random.randint(0, (img.width - self.crop_size) // self.scaling_factor) * self.scaling_factor
+                top = random.randint(0, (img.height - self.crop_size) // self.scaling_factor) * self.scaling_factor
             right = left + self.crop_size
             bottom = top + self.crop_size
             hr_img = img.crop((left, top, right, bottom))
@@ -138,12 +144,19 @@ class ImageTransform(object):
             y_remainder = img.height % self.scaling_factor
             left = x_remainder // 2
             top = x_remainder // 2
+            if lr_img is not None:
+                left, top = 0, 0
             right = left + (img.width - x_remainder)
             bottom = top + (img.height - y_remainder)
             hr_img = img.crop((left, top, right, bottom))
 
-        # Downsize this crop to obtain the low-resolution version of it
-        lr_img = hr_img.resize((int(hr_img.width / self.scaling_factor), int(hr_img.height / self.scaling_factor)), Image.BICUBIC)
+        if lr_img is None:
+            # Downsize this crop to obtain the low-resolution version of it
+            lr_img = hr_img.resize((int(hr_img.width / self.scaling_factor), int(hr_img.height / self.scaling_factor)), Image.BICUBIC)
+        else:
+            # Take the same area out of the rendered low-resolution image
+            lr_img = lr_img.crop((left // self.scaling_factor, top // self.scaling_factor,
+                                  right // self.scaling_factor, bottom // self.scaling_factor))
 
         assert (hr_img.width == lr_img.width * self.scaling_factor) and (hr_img.height == lr_img.height * self.scaling_factor)
 
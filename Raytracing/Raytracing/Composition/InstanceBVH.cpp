@@ -0,0 +1,187 @@
+//
+//	InstanceBVH.cpp
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 26/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#include "InstanceBVH.h"
+#include <chrono>
+#include <limits>
+
+namespace Composition {
+	// ------------------------------------------------------------------------
+	/*! Default Constructor
+	*
+	*   Constructs an empty Instance BVH
+	*/ // ---------------------------------------------------------------------
+	InstanceBVH::InstanceBVH() noexcept :
+		mStructure{ Structure::BVH }, mBuildCost{ 0.f }, mUpdateTime{ 0.0 } {}
+
+	// ------------------------------------------------------------------------
+	/*! Build
+	*
+	*   Builds the tree over the world boxes of the objects, with the given
+	*	builder and threads, or a grid if that is the structure asked for.
+	*	Objects without bounds are kept aside, to be tested against every ray
+	*/ // ---------------------------------------------------------------------
+	void InstanceBVH::Build(const std::vector<std::shared_ptr<Object>>& objects, const Trace::BVH::Builder builder,
+		const unsigned threadCount, const Structure structure) {
+		mBounded.clear();
+		mUnbounded.clear();
+		mSources.clear();
+		mBounds.clear();
+		mTransforms.clear();
+
+		for (const auto& obj : objects) {
+			const Trace::AABB box = obj->GetBounds();
+
+			mSources.push_back(obj.get());
+
+			//If the object has no bounds, no box can cull it
+			if (box.min.x > box.max.x) {
+				mUnbounded.push_back(obj);
+				continue;
+			}
+
+			mBounded.push_back(obj);
+			mBounds.push_back(box);
+			mTransforms.push_back(obj->GetTransform().GetForward());
+		}
+
+		mStructure = structure;
+
+		// Only the structure asked for is kept, the other one is emptied
+		if (structure == Structure::Grid) {
+			mBVH.Build({});
+			mGrid.Build(mBounds);
+		} else {
+			mGrid.Build({});
+			mBVH.Build(mBounds, builder, threadCount);
+			mBuildCost = mBVH.GetCost();
+		}
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Update
+	*
+	*   Brings the tree up to date with the objects. Only those whose
+	*	transform changed since the last update get a new box, and the tree
+	*	is refit around them. It is rebuilt when the objects themselves
+	*	change, or when refits have made it rebuildThreshold times costlier
+	*	than it was when built. Grids aren't refit, but rebuilt whenever
+	*	anything moves. Returns whether it was rebuilt
+	*/ // ---------------------------------------------------------------------
+	bool InstanceBVH::Update(const std::vector<std::shared_ptr<Object>>& objects, const Trace::BVH::Builder builder,
+		const unsigned threadCount, const float rebuildThreshold, const Structure structure) {
+		const auto start = std::chrono::steady_clock::now();
+		bool rebuild = objects.size() != mSources.size() || structure != mStructure;
+
+		for (std::size_t i = 0; i < objects.size() && !rebuild; i++) rebuild = objects[i].get() != mSources[i];
+
+		if (!rebuild) {
+			bool moved = false;
+
+			for (std::size_t i = 0; i < mBounded.size(); i++) {
+				const glm::dmat4 transform = mBounded[i]->GetTransform().GetForward();
+
+				//If the object stayed where it was, so did its box
+				if (transform == mTransforms[i]) continue;
+
+				mTransforms[i] = transform;
+				mBounds[i] = mBounded[i]->GetBounds();
+				moved = true;
+			}
+
+			if (moved && structure == Structure::Grid) rebuild = true;
+			else if (moved) {
+				mBVH.Refit(mBounds);
+				rebuild = mBVH.GetCost() > mBuildCost * rebuildThreshold;
+			}
+		}
+
+		if (rebuild) Build(objects, builder, threadCount, structure);
+
+		mUpdateTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		return rebuild;
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Cast Ray
+	*
+	*   Finds the closest object along the ray, going only into the instances
+	*	whose boxes it crosses before the closest hit so far
+	*/ // ---------------------------------------------------------------------
+	bool InstanceBVH::CastRay(const Trace::Ray& ray, std::shared_ptr<Object>& closestobj, glm::dvec3& inpoint,
+		glm::dvec3& innormal, glm::dvec3& outcolor) const noexcept {
+		double tMax = std::numeric_limits<double>::max();
+		bool hit = false;
+
+		const auto test = [&](const std::uint32_t index, double& t) {
+			return TestInstance(mBounded[index], ray, t, closestobj, inpoint, innormal, outcolor);
+		};
+
+		for (const auto& obj : mUnbounded)
+			hit |= TestInstance(obj, ray, tMax, closestobj, inpoint, innormal, outcolor);
+
+		if (mStructure == Structure::Grid) return mGrid.Intersect(ray.GetOrigin(), ray.GetEndPoint() - ray.GetOrigin(), tMax, test) || hit;
+
+		return mBVH.Intersect(ray.GetOrigin(), ray.GetEndPoint() - ray.GetOrigin(), tMax, test) || hit;
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Is Occluded
+	*
+	*   Returns whether any object but skip lies along the ray, closer than
+	*	maxDistance to its origin. Stops at the first one found
+	*/ // ---------------------------------------------------------------------
+	bool InstanceBVH::IsOccluded(const Trace::Ray& ray, const Object* skip, const double maxDistance) const noexcept {
+		const glm::dvec3 direction = ray.GetEndPoint() - ray.GetOrigin();
+		double tMax = maxDistance / glm::length(direction);
+		glm::dvec3 poi, poiNormal, poiColor;
+
+		const auto test = [&](const std::shared_ptr<Object>& obj) {
+			return obj.get() != skip && obj->TestIntersection(ray, poi, poiNormal, poiColor) &&
+				glm::length(poi - ray.GetOrigin()) < maxDistance;
+		};
+
+		const auto testIndex = [&](const std::uint32_t index, double&) {
+			return test(mBounded[index]);
+		};
+
+		for (const auto& obj : mUnbounded)
+			if (test(obj)) return true;
+
+		if (mStructure == Structure::Grid) return mGrid.Intersect<true>(ray.GetOrigin(), direction, tMax, testIndex);
+
+		return mBVH.Intersect<true>(ray.GetOrigin(), direction, tMax, testIndex);
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Test Instance
+	*
+	*   Tests the ray against an object, keeping the hit if it is closer than
+	*	tMax (in units of the ray direction) and shortening tMax to it
+	*/ // ---------------------------------------------------------------------
+	bool InstanceBVH::TestInstance(const std::shared_ptr<Object>& obj, const Trace::Ray& ray, double& tMax, std::shared_ptr<Object>& closestobj,
+		glm::dvec3& inpoint, glm::dvec3& innormal, glm::dvec3& outcolor) noexcept {
+		const glm::dvec3 direction = ray.GetEndPoint() - ray.GetOrigin();
+		glm::dvec3 point, normal, color;
+
+		//If the object is missed, there is nothing to keep
+		if (!obj->TestIntersection(ray, point, normal, color)) return false;
+
+		const double t = glm::dot(point - ray.GetOrigin(), direction) / glm::dot(direction, direction);
+
+		//If something closer was already found, this hit is hidden behind it
+		if (t >= tMax) return false;
+
+		tMax = t;
+		closestobj = obj;
+		inpoint = point;
+		innormal = normal;
+		outcolor = color;
+		return true;
+	}
+}
@@ -0,0 +1,109 @@
+//
+//	InstanceBVH.h
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 26/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#ifndef _INSTANCE_BVH__H_
+#define _INSTANCE_BVH__H_
+
+#include <memory>
+#include <vector>
+#include "Object.h"
+#include "../Trace/UniformGrid.h"
+
+namespace Composition {
+	// Top level of the acceleration structure. It only holds the world boxes of the
+	// objects, which take rays into their own space and down their own (bottom
+	// level) trees, so copies of an asset share all its geometry but the transform.
+	// The boxes can go in a uniform grid instead of a tree
+	class InstanceBVH {
+#pragma region //Declarations
+	public:
+		// Trees suit most scenes. Grids are built in linear time, for many objects
+		// of about the same size that move every frame
+		enum class Structure {
+			BVH,
+			Grid
+		};
+#pragma endregion
+
+#pragma region //Constructors & Destructors
+	public:
+		InstanceBVH() noexcept;
+#pragma endregion
+
+#pragma region //Methods
+		void Build(const std::vector<std::shared_ptr<Object>>& objects, const Trace::BVH::Builder builder = Trace::BVH::Builder::SAH,
+			const unsigned threadCount = 0, const Structure structure = Structure::BVH);
+		bool Update(const std::vector<std::shared_ptr<Object>>& objects, const Trace::BVH::Builder builder, const unsigned threadCount,
+			const float rebuildThreshold, const Structure structure = Structure::BVH);
+		bool CastRay(const Trace::Ray& ray, std::shared_ptr<Object>& closestobj, glm::dvec3& inpoint, glm::dvec3& innormal,
+			glm::dvec3& outcolor) const noexcept;
+		DONTDISCARD bool IsOccluded(const Trace::Ray& ray, const Object* skip, const double maxDistance) const noexcept;
+		DONTDISCARD inline double GetBuildTime() const noexcept;
+		DONTDISCARD inline double GetUpdateTime() const noexcept;
+		static inline void SetActive(const InstanceBVH* instances) noexcept;
+		DONTDISCARD static inline const InstanceBVH* GetActive() noexcept;
+	private:
+		static bool TestInstance(const std::shared_ptr<Object>& obj, const Trace::Ray& ray, double& tMax, std::shared_ptr<Object>& closestobj,
+			glm::dvec3& inpoint, glm::dvec3& innormal, glm::dvec3& outcolor) noexcept;
+#pragma endregion
+
+#pragma region //Members
+		Structure mStructure;
+		Trace::BVH mBVH;
+		Trace::UniformGrid mGrid;
+		std::vector<std::shared_ptr<Object>> mBounded;
+		std::vector<std::shared_ptr<Object>> mUnbounded;
+		std::vector<const Object*> mSources;
+		std::vector<Trace::AABB> mBounds;
+		std::vector<glm::dmat4> mTransforms;
+		float mBuildCost;
+		double mUpdateTime;
+		inline static thread_local const InstanceBVH* mActive;
+#pragma endregion
+	};
+
+	// ------------------------------------------------------------------------
+	/*! Get Build Time
+	*
+	*   Returns how long the last Build took to build the tree (or grid), in
+	*	milliseconds
+	*/ // ---------------------------------------------------------------------
+	double InstanceBVH::GetBuildTime() const noexcept {
+		return mStructure == Structure::Grid ? mGrid.GetBuildTime() : mBVH.GetBuildTime();
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Get Update Time
+	*
+	*   Returns how long the last Update took, refit or rebuild, in milliseconds
+	*/ // ---------------------------------------------------------------------
+	double InstanceBVH::GetUpdateTime() const noexcept {
+		return mUpdateTime;
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Set Active
+	*
+	*   Sets the structure the rays traced on this thread go through, or none
+	*	for them to test every object they are given
+	*/ // ---------------------------------------------------------------------
+	void InstanceBVH::SetActive(const InstanceBVH* instances) noexcept {
+		mActive = instances;
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Get Active
+	*
+	*   Returns the structure the rays traced on this thread go through
+	*/ // ---------------------------------------------------------------------
+	const InstanceBVH* InstanceBVH::GetActive() noexcept {
+		return mActive;
+	}
+}
+
+#endif
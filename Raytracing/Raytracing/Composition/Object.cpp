@@ -10,6 +10,12 @@
 #include "../Graphics/Primitives/Material.h"
 
 namespace Composition {
+	namespace {
+		// Slack on the local box, so rays grazing the surface in double precision
+		// aren't rejected by rounding on the slabs
+		constexpr double cBoundsTolerance = 1e-9;
+	}
+
 	// ------------------------------------------------------------------------
 	/*! Default Constructor
 	*
@@ -35,4 +41,64 @@ namespace Composition {
 		mHasMaterial = static_cast<bool>(objMaterial);
 		return mHasMaterial;
 	}
+
+	// ------------------------------------------------------------------------
+	/*! Get Bounds
+	*
+	*   Returns the box around the object in world space, through the corners
+	*	of its local one. It is padded a little, so hits computed in double
+	*	precision don't fall off the single precision box
+	*/ // ---------------------------------------------------------------------
+	Trace::AABB Object::GetBounds() const noexcept {
+		const Trace::AABB local = GetLocalBounds();
+		Trace::AABB bounds;
+
+		//If the object is unbounded, so is it anywhere
+		if (local.min.x > local.max.x) return bounds;
+
+		for (int i = 0; i < 8; i++)
+			bounds.Grow(glm::vec3(mTransform.ApplyTransform({ i & 1 ? local.max.x : local.min.x, i & 2 ? local.max.y : local.min.y,
+				i & 4 ? local.max.z : local.min.z })));
+
+		const glm::vec3 padding = (bounds.max - bounds.min) * 1e-4f + 1e-4f;
+
+		bounds.min -= padding;
+		bounds.max += padding;
+		return bounds;
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Hits Local Bounds
+	*
+	*   Slab test of a ray, already in the space of the object, against its
+	*	local box. Shapes check it before solving for their surface, as most
+	*	rays miss most objects and it is far cheaper than the actual test.
+	*	Gives back the stretch of the ray within the box, from its origin on
+	*/ // ---------------------------------------------------------------------
+	bool Object::HitsLocalBounds(const Trace::AABB& bounds, const glm::dvec3& origin, const glm::dvec3& direction,
+		double& tEnter, double& tExit) noexcept {
+		tEnter = 0.0;
+		tExit = std::numeric_limits<double>::max();
+
+		for (int i = 0; i < 3; i++) {
+			const double min = bounds.min[i] - cBoundsTolerance, max = bounds.max[i] + cBoundsTolerance;
+
+			//If the ray runs parallel to the slab, it has to start between its planes
+			if (direction[i] == 0.0) {
+				if (origin[i] < min || origin[i] > max) return false;
+				continue;
+			}
+
+			const double inverse = 1.0 / direction[i];
+			const double t1 = (min - origin[i]) * inverse, t2 = (max - origin[i]) * inverse;
+
+			tEnter = std::max(tEnter, std::min(t1, t2));
+			tExit = std::min(tExit, std::max(t1, t2));
+
+			//If the slabs don't overlap along the ray, it misses the box
+			if (tEnter > tExit) return false;
+		}
+
+		return true;
+	}
 }
\ No newline at end of file
@@ -10,6 +10,7 @@
 #define _OBJECT__H_
 
 #include "../Trace/Ray.h"
+#include "../Trace/BVH.h"
 #include <glm/glm.hpp>
 #include "../Math/Transform.h"
 #include "../CommonDefines.h"
@@ -29,20 +30,31 @@ namespace Composition {
 	#pragma endregion
 
 	#pragma region //Methods
-		inline void SetTransform(const Math::Transform& transform) noexcept;
+		virtual inline void SetTransform(const Math::Transform& transform) noexcept;
+		inline void AdvanceFrame() noexcept;
+		DONTDISCARD inline const Math::Transform& GetTransform() const noexcept;
+		DONTDISCARD inline const Math::Transform& GetPreviousTransform() const noexcept;
 		DONTDISCARD virtual inline bool TestIntersection(const Trace::Ray& ray, glm::dvec3 & inpoint, glm::dvec3& innormal, glm::dvec3& outcolor) noexcept;
 		DONTDISCARD virtual inline bool CloseEnough(const double f1, const double f2) noexcept;
+		DONTDISCARD virtual inline Trace::AABB GetLocalBounds() const noexcept;
+		DONTDISCARD virtual inline double GetBuildTime() const noexcept;
+		DONTDISCARD Trace::AABB GetBounds() const noexcept;
 		void inline SetColor(const glm::dvec3& color) noexcept;
 		bool AssignMaterial(const std::shared_ptr<Graphics::Primitives::Material>& objMaterial) noexcept;
 		DONTDISCARD inline bool HasMaterial() const noexcept;
 		DONTDISCARD inline std::shared_ptr<Graphics::Primitives::Material> GetMaterial() const noexcept;
 		DONTDISCARD inline glm::dvec3 GetColor() const noexcept;
+	protected:
+		DONTDISCARD static inline bool HitsLocalBounds(const Trace::AABB& bounds, const glm::dvec3& origin, const glm::dvec3& direction) noexcept;
+		DONTDISCARD static bool HitsLocalBounds(const Trace::AABB& bounds, const glm::dvec3& origin, const glm::dvec3& direction,
+			double& tEnter, double& tExit) noexcept;
 	#pragma endregion
 
 	#pragma region //Members
 	protected:
 		glm::dvec3 mColor;
 		Math::Transform mTransform;
+		Math::Transform mPreviousTransform;
 		std::shared_ptr<Graphics::Primitives::Material> mMaterial;
 		bool mHasMaterial;
 	#pragma endregion
@@ -57,6 +69,33 @@ namespace Composition {
 		mTransform = transform;
 	}
 
+	// ------------------------------------------------------------------------
+	/*! Advance Frame
+	*
+	*   Remembers the current transform as the one of the previous frame
+	*/ // ---------------------------------------------------------------------
+	void Object::AdvanceFrame() noexcept {
+		mPreviousTransform = mTransform;
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Get Transform
+	*
+	*   Returns the current transform of the object
+	*/ // ---------------------------------------------------------------------
+	const Math::Transform& Object::GetTransform() const noexcept {
+		return mTransform;
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Get Previous Transform
+	*
+	*   Returns the transform the object had on the previous frame
+	*/ // ---------------------------------------------------------------------
+	const Math::Transform& Object::GetPreviousTransform() const noexcept {
+		return mPreviousTransform;
+	}
+
 	// ------------------------------------------------------------------------
 	/*! Set Color
 	*
@@ -84,6 +123,38 @@ namespace Composition {
 		return fabs(f1 - f2) < std::numeric_limits<double>::epsilon();
 	}
 
+	// ------------------------------------------------------------------------
+	/*! Get Local Bounds
+	*
+	*   Returns the box around the object, before its transform. Objects
+	*	without one (empty) are tested against every ray
+	*/ // ---------------------------------------------------------------------
+	Trace::AABB Object::GetLocalBounds() const noexcept {
+		return Trace::AABB{};
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Get Build Time
+	*
+	*   Returns how long the object took to build a tree of its own, in
+	*	milliseconds. Most objects have none
+	*/ // ---------------------------------------------------------------------
+	double Object::GetBuildTime() const noexcept {
+		return 0.0;
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Hits Local Bounds
+	*
+	*   Returns whether a ray, already in the space of the object, goes through
+	*	its local box
+	*/ // ---------------------------------------------------------------------
+	bool Object::HitsLocalBounds(const Trace::AABB& bounds, const glm::dvec3& origin, const glm::dvec3& direction) noexcept {
+		double tEnter, tExit;
+
+		return HitsLocalBounds(bounds, origin, direction, tEnter, tExit);
+	}
+
 	// ------------------------------------------------------------------------
 	/*! Has Material
 	*
@@ -12,7 +12,15 @@
 #include "../Graphics/Materials/MetalicMaterial.h"
 #include "../Graphics/Shapes/Cone.h"
 #include "../Graphics/Shapes/Cylinder.h"
+#include "../Graphics/Sampling/BoxFilter.h"
+#include "../Graphics/Sampling/SampleContext.h"
+#include "../Graphics/Sampling/StratifiedSampler.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
 #include <iostream>
+#include <mutex>
+#include <thread>
 
 namespace Composition {
 
@@ -21,7 +29,8 @@ namespace Composition {
 	*
 	*   Renders the whole Scene into out framebuffer
 	*/ // ---------------------------------------------------------------------
-	Scene::Scene() {
+	Scene::Scene() :
+		mAccumulation{ 0, 0 }, mVerbose{ true } {
 		auto testMat = std::make_shared<Graphics::Materials::MetalicMaterial>();
 		testMat->SetColor(glm::dvec3(0.25f, 0.5f, 0.8f));
 		testMat->SetReflectivity(0.5f);
@@ -43,8 +52,8 @@ namespace Composition {
 		mObjects.emplace_back(std::make_shared<Graphics::Shapes::Cone>());
 		mObjects.emplace_back(std::make_shared<Graphics::Shapes::Sphere>());
 		mObjects.emplace_back(std::make_shared<Graphics::Shapes::Cylinder>());
-		mObjects.emplace_back(std::make_shared<Graphics::Shapes::Plane>());
-		//mObjects.emplace_back(std::make_shared<Graphics::Shapes::Plane>());
+		mObjects.emplace_back(std::make_shared<Graphics::Shapes::Quad>());
+		//mObjects.emplace_back(std::make_shared<Graphics::Shapes::Quad>());
 
 		Math::Transform t1;
 		t1.SetTransform(glm::vec4(-1.5f, 0.f, 0.f, 1.f), 
@@ -66,12 +75,12 @@ namespace Composition {
 			glm::vec4(0.f, 0.f, 0.f, 1.f),
 			glm::vec4(18.f, 8.f, 1.f, 1.f));
 
-		auto leftWall = std::make_shared<Graphics::Shapes::Plane>();
+		auto leftWall = std::make_shared<Graphics::Shapes::Quad>();
 		leftWall->SetTransform(Math::Transform{ glm::vec3{-4.0, 0.0, 0.0},
 																glm::vec3{0.0, -PI / 2.0, -PI / 2.0},
 																									glm::vec3{16.0, 16.0, 1.0} });
 
-		auto backWall = std::make_shared<Graphics::Shapes::Plane>();
+		auto backWall = std::make_shared<Graphics::Shapes::Quad>();
 		backWall->SetTransform(Math::Transform{ glm::vec3{0.0, 4.0, 0.0},
 																								glm::vec3{-PI / 2.0, 0.0, 0.0},
 																								glm::vec3{36.0, 16.0, 1.0} });
@@ -107,109 +116,308 @@ namespace Composition {
 		mLights.push_back(std::make_shared<Graphics::Primitives::Lighting::PointLight>());
 		mLights[2]->SetPosition(glm::dvec3{ 0.0, -10.0, -5.0 });
 		mLights[2]->SetColor(glm::dvec3{ 0.f, 1.f, 0.f });
+
+		mMaterials.push_back(testMat);
+		mMaterials.push_back(wallMaterial);
+		AdvanceFrame();
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Randomize
+	*
+	*   Moves the camera, objects and lights to a random variation of the
+	*	default layout, and picks new colors and material parameters
+	*/ // ---------------------------------------------------------------------
+	void Scene::Randomize(std::mt19937_64& generator) {
+		std::uniform_real_distribution<double> unit(0.0, 1.0);
+		const auto range = [&](const double min, const double max) { return min + (max - min) * unit(generator); };
+		const auto color = [&]() { return glm::dvec3{ range(0.1, 1.0), range(0.1, 1.0), range(0.1, 1.0) }; };
+
+		// Orbit the camera around the objects, always looking at them from the front
+		const double angle = range(-0.9, 0.9);
+		const double distance = range(4.5, 8.0);
+
+		mCamera.SetPosition({ distance * std::sin(angle), -distance * std::cos(angle), range(-3.5, -0.75) });
+		mCamera.SetLookAt({ range(-0.5, 0.5), range(-0.5, 0.5), range(-0.25, 0.25) });
+
+		// Shuffle the cone, sphere and cylinder around their slots, resting on the floor or above it
+		for (std::size_t i = 0; i < 3; i++) {
+			const double scale = range(0.35, 0.65);
+
+			mObjects[i]->SetTransform(Math::Transform{ glm::dvec3{ -1.5 + 1.5 * i + range(-0.3, 0.3), range(-0.5, 0.5), 0.75 - scale - range(0.0, 0.5) },
+														glm::dvec3{ range(-0.3, 0.3), range(-0.3, 0.3), range(0.0, 2.0 * PI) },
+														glm::dvec3{ scale, scale, scale } });
+		}
+
+		for (auto& obj : mObjects) obj->SetColor(color());
+
+		// Pick new light positions and hues, keeping the brightest channel at full intensity
+		for (auto& light : mLights) {
+			const glm::dvec3 hue = color();
+
+			light->SetPosition({ range(-8.0, 8.0), range(-12.0, -4.0), range(-8.0, -2.0) });
+			light->SetColor(hue / std::max(hue.x, std::max(hue.y, hue.z)));
+		}
+
+		for (auto& material : mMaterials) {
+			material->SetColor(color());
+			material->SetReflectivity(range(0.0, 0.8));
+			material->SetShininess(range(0.0, 20.0));
+		}
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Advance Frame
+	*
+	*   Makes the current camera and object transforms the previous frame ones,
+	*	against which the motion vectors of the next render are computed
+	*/ // ---------------------------------------------------------------------
+	void Scene::AdvanceFrame() noexcept {
+		mPreviousCamera = mCamera;
+		for (auto& obj : mObjects) obj->AdvanceFrame();
 	}
 
 	// ------------------------------------------------------------------------
 	/*! Render
 	*
-	*   Renders the whole Scene into out framebuffer
+	*   Renders the whole Scene into out framebuffer, spreading its tiles among
+	*	worker threads. If a GBuffer is given, it also gets the depth, normal,
+	*	albedo and ids of every primary hit, plus motion vectors against the
+	*	state saved by the last AdvanceFrame.
+	*	Samples are splatted into the pixels around them, so tiles go in four
+	*	phases, one per corner of every 2x2 block of tiles. Tiles of the same
+	*	phase are a whole tile apart, further than any splat reaches, so they
+	*	never write the same pixel. Objects only move between renders, so the
+	*	tree over their instances is brought up to date once per render
 	*/ // ---------------------------------------------------------------------
-	bool Scene::Render(Core::FrameBuffer& fb) {
-		// Get the dimensions of the output image.
-		int xSize = fb.GetWidth();
-		int ySize = fb.GetHeight();
+	bool Scene::Render(Core::FrameBuffer& fb, Core::GBuffer* gbuffer, const RenderSettings& settings) {
+		const Graphics::Sampling::BoxFilter box;
+		const Graphics::Sampling::Filter& filter = settings.filter ? *settings.filter : box;
+		const std::size_t tileSize = std::max<std::size_t>(settings.tileSize, 2 * static_cast<std::size_t>(std::ceil(filter.GetRadius())) + 1);
+		const std::size_t tilesX = (fb.GetWidth() + tileSize - 1) / tileSize;
+		const std::size_t tileCount = tilesX * ((fb.GetHeight() + tileSize - 1) / tileSize);
+		const unsigned threadCount = settings.threadCount ? settings.threadCount : std::max(std::thread::hardware_concurrency(), 1u);
+		const Graphics::Sampling::StratifiedSampler stratified(std::max(settings.maxSamples, 1u), settings.frame);
+		const Graphics::Sampling::Sampler& sampler = settings.sampler ? *settings.sampler : stratified;
+		std::vector<std::size_t> phases[4];
+		std::atomic<std::size_t> done{ 0 };
+		std::mutex console;
+
+		mIds.clear();
+		const bool rebuilt = mInstances.Update(mObjects, settings.instanceBuilder, threadCount, settings.rebuildThreshold,
+			settings.instanceStructure);
+
+		if (mVerbose) {
+			std::cout << (rebuilt ? "Built" : "Updated") << " the tree over " << mObjects.size() << " objects in " <<
+				mInstances.GetUpdateTime() << " ms";
+
+			// On rebuilds, also tell the tree itself apart from those the objects built over their own geometry
+			if (rebuilt) {
+				double objectTime = 0.0;
+
+				for (const auto& obj : mObjects) objectTime += obj->GetBuildTime();
+				std::cout << " (" << mInstances.GetBuildTime() << " ms building it, the objects' own trees took " << objectTime << " ms)";
+			}
 
-		// Loop over each pixel in our image.
-		Trace::Ray cameraRay;
-		glm::dvec3 intPoint;
-		glm::dvec3 localNormal;
-		glm::dvec3 localColor;
-		double xFact = 1.0 / (static_cast<double>(xSize) / 2.0);
-		double yFact = 1.0 / (static_cast<double>(ySize) / 2.0);
-		double minDist = 1e6;
-		double maxDist = 0.0;
-		for (int y = ySize - 1; y >= 0; --y) {
-
-			std::cout << "Rendering row " << y+1 << " of " << ySize << std::endl;
-
-			for (int x = 0; x < xSize; ++x) {
-				// Normalize the x and y coordinates.
-				double normX = (static_cast<double>(x) * xFact) - 1.0;
-				double normY = (static_cast<double>(y) * yFact) - 1.0;
-
-				// Generate the ray for this pixel.
-				mCamera.GenerateRay(normX, normY, cameraRay);
-
-				// Test for intersections with all objects in the scene.
-				std::shared_ptr<Composition::Object> closestObject;
-				glm::dvec3 closestIntPoint;
-				glm::dvec3 closestLocalNormal;
-				glm::dvec3 closestLocalColor;
-				bool intersectionFound = CastRay(cameraRay, closestObject, closestIntPoint, closestLocalNormal, closestLocalColor);
-
-				/* Compute the illumination for the closest object, assuming that there
-					was a valid intersection. */
-				if (intersectionFound)
-				{
-					// Check if the object has a material.
-					if (closestObject->HasMaterial()) {
-						Graphics::Primitives::Material::mReflectionRayCount = 0;
-						// Use the material to compute the color.
-						glm::dvec3 matColor = closestObject->GetMaterial()->ComputeColor(mObjects, mLights,
-							closestObject, closestIntPoint,
-							closestLocalNormal, cameraRay);
-						fb.SetColor(x, y, sf::Color(matColor.x * 255, matColor.y * 255, matColor.z * 255, 1));
-					}
-					else
-					{
-						// Use the basic method to compute the color.
-						glm::dvec3 matColor = Graphics::Primitives::Material::ComputeColorDiffuse(mObjects, mLights,
-							closestObject, closestIntPoint,
-							closestLocalNormal, closestObject->GetColor());
-						fb.SetColor(x, y, sf::Color(matColor.x * 255, matColor.y * 255, matColor.z * 255, 1));
-					}
+			std::cout << std::endl;
+		}
+
+		mAccumulation.SetSize(fb.GetWidth(), fb.GetHeight());
+
+		if (gbuffer) {
+			std::vector<const Graphics::Primitives::Material*> materials;
+
+			if (gbuffer->GetWidth() != fb.GetWidth() || gbuffer->GetHeight() != fb.GetHeight())
+				gbuffer->SetSize(fb.GetWidth(), fb.GetHeight());
+			else gbuffer->Clear();
+
+			// Number the objects, and the materials in order of appearance, so objects sharing one get the same id
+			for (std::size_t i = 0; i < mObjects.size(); i++) {
+				const auto& obj = mObjects[i];
+				std::uint32_t material = 0;
+
+				if (obj->HasMaterial()) {
+					const auto found = std::find(materials.begin(), materials.end(), obj->GetMaterial().get());
+
+					material = static_cast<std::uint32_t>(std::distance(materials.begin(), found) + 1);
+					if (found == materials.end()) materials.push_back(obj->GetMaterial().get());
 				}
+
+				mIds[obj.get()] = { static_cast<std::uint32_t>(i + 1), material };
 			}
 		}
 
+		for (std::size_t tile = 0; tile < tileCount; tile++)
+			phases[(tile % tilesX & 1) + 2 * (tile / tilesX & 1)].push_back(tile);
+
+		for (const std::vector<std::size_t>& phase : phases) {
+			std::atomic<std::size_t> nextTile{ 0 };
+			std::vector<std::thread> workers;
+
+			// Every worker keeps grabbing the next unrendered tile of the phase
+			const auto work = [&]() {
+				for (std::size_t i = nextTile++; i < phase.size(); i = nextTile++) {
+					const std::size_t x0 = phase[i] % tilesX * tileSize, y0 = phase[i] / tilesX * tileSize;
+
+					RenderTile(gbuffer, settings, sampler, filter, x0, y0, std::min(x0 + tileSize, fb.GetWidth()),
+						std::min(y0 + tileSize, fb.GetHeight()));
+
+					const std::size_t finished = ++done;
+
+					if (mVerbose && finished * 10 / tileCount != (finished - 1) * 10 / tileCount) {
+						std::lock_guard<std::mutex> lock(console);
+						std::cout << "Rendered " << finished << " of " << tileCount << " tiles" << std::endl;
+					}
+				}
+			};
+
+			for (unsigned i = 1; i < std::min<std::size_t>(threadCount, phase.size()); i++)
+				workers.emplace_back(work);
+
+			work();
+			for (std::thread& worker : workers) worker.join();
+		}
+
+		for (std::size_t y = 0; y < fb.GetHeight(); y++)
+			for (std::size_t x = 0; x < fb.GetWidth(); x++)
+				fb.SetRadiance(x, y, mAccumulation.GetFiltered(x, y));
+
 		return true;
 	}
 
+	// ------------------------------------------------------------------------
+	/*! Render Tile
+	*
+	*   Traces batches of samples over the tile [x0, x1) x [y0, y1) until it
+	*	is clean enough or out of budget, splatting each of them through the
+	*	filter. Samples only depend on the pixel and their index, so the tile
+	*	renders the same on any thread
+	*/ // ---------------------------------------------------------------------
+	void Scene::RenderTile(Core::GBuffer* gbuffer, const RenderSettings& settings, const Graphics::Sampling::Sampler& sampler,
+		const Graphics::Sampling::Filter& filter, const std::size_t x0, const std::size_t y0, const std::size_t x1, const std::size_t y1) {
+		const int xSize = static_cast<int>(mAccumulation.GetWidth()), ySize = static_cast<int>(mAccumulation.GetHeight());
+		const unsigned minSamples = std::max(settings.minSamples, 1u);
+		const unsigned maxSamples = std::max(settings.maxSamples, minSamples);
+		const double xFact = 2.0 / static_cast<double>(xSize);
+		const double yFact = 2.0 / static_cast<double>(ySize);
+		const double radius = filter.GetRadius();
+		Trace::Ray cameraRay;
+
+		Graphics::Primitives::Material::mReflectionCountMax = static_cast<int>(settings.maxDepth);
+		Graphics::Primitives::Material::mRouletteDepth = static_cast<int>(settings.rouletteDepth);
+		Graphics::Primitives::Material::mThroughputCutoff = settings.throughputCutoff;
+		InstanceBVH::SetActive(&mInstances);
+
+		for (unsigned samples = 0; samples < maxSamples;) {
+			const unsigned batch = std::min(minSamples, maxSamples - samples);
+
+			for (std::size_t y = y0; y < y1; y++)
+				for (std::size_t x = x0; x < x1; x++)
+					for (unsigned s = samples; s < samples + batch; s++) {
+						const glm::dvec2 offset = maxSamples > 1 || settings.frame ? sampler.Get2D(static_cast<std::uint32_t>(x),
+							static_cast<std::uint32_t>(y), s, 0) : glm::dvec2(0.5);
+
+						// Normalize the x and y coordinates, going through the sampled point of the pixel.
+						const double normX = ((static_cast<double>(x) + offset.x) * xFact) - 1.0;
+						const double normY = ((static_cast<double>(y) + offset.y) * yFact) - 1.0;
+
+						mCamera.GenerateRay(normX, normY, cameraRay);
+
+						// Whatever is sampled along the path keeps drawing from this pixel's sequence
+						Graphics::Sampling::SampleContext::Begin(&sampler, static_cast<std::uint32_t>(x), static_cast<std::uint32_t>(y), s);
+
+						const glm::vec3 radiance = TraceSample(cameraRay, s ? nullptr : gbuffer, x, y, normX, normY);
+						const double sx = static_cast<double>(x) + offset.x, sy = static_cast<double>(y) + offset.y;
+
+						mAccumulation.AddSample(x, y, radiance);
+
+						// Weight the sample into every pixel whose center the filter reaches
+						const int px0 = std::max(static_cast<int>(std::ceil(sx - 0.5 - radius)), 0);
+						const int py0 = std::max(static_cast<int>(std::ceil(sy - 0.5 - radius)), 0);
+						const int px1 = std::min(static_cast<int>(std::floor(sx - 0.5 + radius)), xSize - 1);
+						const int py1 = std::min(static_cast<int>(std::floor(sy - 0.5 + radius)), ySize - 1);
+
+						for (int py = py0; py <= py1; py++)
+							for (int px = px0; px <= px1; px++) {
+								const double weight = filter.Evaluate({ px + 0.5 - sx, py + 0.5 - sy });
+
+								if (weight != 0.0) mAccumulation.Splat(px, py, radiance, static_cast<float>(weight));
+							}
+					}
+
+			samples += batch;
+
+			//If the whole tile is already clean, the remaining samples are better spent elsewhere
+			if (mAccumulation.GetError(x0, y0, x1, y1) <= settings.noiseThreshold) break;
+		}
+
+		// Neither the sampler nor the instance tree outlive the render
+		Graphics::Sampling::SampleContext::Begin(nullptr, 0, 0, 0);
+		InstanceBVH::SetActive(nullptr);
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Trace Sample
+	*
+	*   Returns the radiance carried by a camera ray. Given a GBuffer, also
+	*	stores what the ray hit on the pixel it went through
+	*/ // ---------------------------------------------------------------------
+	glm::dvec3 Scene::TraceSample(const Trace::Ray& cameraRay, Core::GBuffer* gbuffer, const std::size_t x,
+		const std::size_t y, const double normX, const double normY) {
+		// Test for intersections with all objects in the scene.
+		std::shared_ptr<Composition::Object> closestObject;
+		glm::dvec3 closestIntPoint;
+		glm::dvec3 closestLocalNormal;
+		glm::dvec3 closestLocalColor;
+		bool intersectionFound = CastRay(cameraRay, closestObject, closestIntPoint, closestLocalNormal, closestLocalColor);
+
+		if (gbuffer) {
+			// Move the hit back with its object (or the background along with the camera) and see where it landed
+			const glm::dvec3 previousPoint = intersectionFound ? closestObject->GetPreviousTransform().ApplyTransform(
+				closestObject->GetTransform().InverseApplyTransform(closestIntPoint)) :
+				mPreviousCamera.GetPosition() + (cameraRay.GetEndPoint() - cameraRay.GetOrigin());
+			glm::dvec2 previous;
+
+			if (mPreviousCamera.Project(previousPoint, previous))
+				gbuffer->SetMotion(x, y, { (previous.x - normX) * gbuffer->GetWidth() / 2.0, (previous.y - normY) * gbuffer->GetHeight() / 2.0 });
+		}
+
+		//If nothing was hit, no light comes back
+		if (!intersectionFound) return glm::dvec3(0.0);
+
+		// Keep what the pixel sees, which is otherwise lost after shading
+		if (gbuffer) {
+			const glm::dvec3 cameraPosition = mCamera.GetPosition();
+			const glm::uvec2 ids = mIds.find(closestObject.get())->second;
+
+			gbuffer->SetSample(x, y, static_cast<float>(glm::dot(closestIntPoint - cameraPosition, glm::normalize(mCamera.GetLookAt() - cameraPosition))),
+				glm::normalize(closestLocalNormal), closestObject->HasMaterial() ? closestObject->GetMaterial()->GetColor() :
+				closestObject->GetColor(), ids.x, ids.y);
+		}
+
+		// Check if the object has a material.
+		if (closestObject->HasMaterial()) {
+			Graphics::Primitives::Material::mReflectionRayCount = 0;
+			Graphics::Primitives::Material::mThroughput = glm::dvec3(1.0);
+
+			// Use the material to compute the color.
+			return closestObject->GetMaterial()->ComputeColor(mObjects, mLights, closestObject, closestIntPoint,
+				closestLocalNormal, cameraRay);
+		}
+
+		// Use the basic method to compute the color.
+		return Graphics::Primitives::Material::ComputeColorDiffuse(mObjects, mLights, closestObject, closestIntPoint,
+			closestLocalNormal, closestObject->GetColor());
+	}
+
 	// ------------------------------------------------------------------------
 	/*! Cast Ray
 	*
-	*   Casts a ray into the scene
+	*   Casts a ray into the scene, through the instance tree built by the
+	*	last Render
 	*/ // ---------------------------------------------------------------------
 	bool Scene::CastRay(const Trace::Ray& ray, std::shared_ptr<Object>& closestobj, 
 									glm::dvec3& inpoint, glm::dvec3& innormal, glm::dvec3& outcolor) {
-		glm::dvec3 closestIntersection;
-		glm::dvec3 closestNormal;
-		glm::dvec3 closestColor;
-		double minDist = std::numeric_limits<double>::max();
-		bool foundIntersection = false;
-
-		// Loop over each object in the scene.
-		for (auto& obj : mObjects) {
-
-			// Test if we have a valid intersection.
-			// If we have a valid intersection, change pixel color to red.
-			if (obj->TestIntersection(ray, closestIntersection, closestNormal, closestColor)) {
-				foundIntersection = true;
-
-				// Calculate the distance from the camera to the intersection point.
-				const double dist = glm::length(closestIntersection - ray.GetOrigin());
-
-				// If this is the closest object, store the intersection point and color.
-				if (dist < minDist) {
-					minDist = dist;
-					inpoint = closestIntersection;
-					innormal = closestNormal;
-					outcolor = closestColor;
-					closestobj = obj;
-				}
-			}
-		}
-
-		return foundIntersection;
+		return mInstances.CastRay(ray, closestobj, inpoint, innormal, outcolor);
 	}
 }
\ No newline at end of file
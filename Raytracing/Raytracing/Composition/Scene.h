@@ -9,15 +9,56 @@
 #ifndef _SCENE__H_
 #define _SCENE__H_
 
+#include <cstdint>
 #include <memory>
+#include <random>
+#include <unordered_map>
 #include <vector>
+#include "../Core/AccumulationBuffer.h"
 #include "../Core/FrameBuffer.h"
+#include "../Core/GBuffer.h"
+#include "InstanceBVH.h"
 #include "../Graphics/Shapes/Sphere.h"
 #include "../Graphics/Shapes/Plane.h"
+#include "../Graphics/Shapes/Quad.h"
 #include "../Graphics/Primitives/Camera.h"
 #include "../Graphics/Primitives/Lighting/Light.h"
+#include "../Graphics/Materials/MetalicMaterial.h"
+#include "../Graphics/Sampling/Filter.h"
+#include "../Graphics/Sampling/Sampler.h"
 
 namespace Composition {
+	// How many camera rays the pixels get. Tiles keep tracing batches of minSamples rays
+	// per pixel until their relative noise drops below the threshold or they reach maxSamples.
+	// A single sample of frame 0 goes through the pixel center, any other is placed by the
+	// sampler (stratified over maxSamples if none is given, seeded by frame so successive
+	// renders draw different samples, and single ones jitter over the pixel; given samplers
+	// keep their own seed). The G-buffer keeps what the first sample hit. Samples are spread over the nearby
+	// pixels by the reconstruction filter, a box around each pixel if none is given.
+	// Paths end after maxDepth reflections (a single one by default, so the image is
+	// deterministic), and those past rouletteDepth bounces
+	// survive with a chance proportional to what they still carry. Paths carrying less than throughputCutoff are dropped
+	// outright, which is biased and thus off by default. The tree over the objects is
+	// built by instanceBuilder, LBVH being the faster one to build. Renders after objects
+	// move only refit it, until that makes it rebuildThreshold times costlier to trace.
+	// Scenes of many small objects moving every frame may use a grid instead
+	// (instanceStructure), rebuilt on every render something moved
+	struct RenderSettings {
+		unsigned minSamples = 1, maxSamples = 1;
+		std::uint32_t frame = 0;
+		float noiseThreshold = 0.02f;
+		unsigned tileSize = 16;
+		unsigned threadCount = 0;
+		unsigned maxDepth = 1;
+		unsigned rouletteDepth = 1;
+		double throughputCutoff = 0.0;
+		Trace::BVH::Builder instanceBuilder = Trace::BVH::Builder::SAH;
+		float rebuildThreshold = 1.5f;
+		InstanceBVH::Structure instanceStructure = InstanceBVH::Structure::BVH;
+		std::shared_ptr<const Graphics::Sampling::Sampler> sampler;
+		std::shared_ptr<const Graphics::Sampling::Filter> filter;
+	};
+
 	class Scene {
 	#pragma region //Constructor
 	public:
@@ -25,17 +66,72 @@ namespace Composition {
 	#pragma endregion
 
 	#pragma region //Method
-		bool Render(Core::FrameBuffer& fb);
+		bool Render(Core::FrameBuffer& fb, Core::GBuffer* gbuffer = nullptr, const RenderSettings& settings = {});
 		bool CastRay(const Trace::Ray& ray, std::shared_ptr<Object>&closestobj, glm::dvec3& inpoint, glm::dvec3& innormal, glm::dvec3& outcolor);
+		void Randomize(std::mt19937_64& generator);
+		void AdvanceFrame() noexcept;
+		inline void AddObject(const std::shared_ptr<Object>& obj);
+		inline void AddLight(const std::shared_ptr<Graphics::Primitives::Lighting::Light>& light);
+		inline void SetVerbose(const bool verbose) noexcept;
+		DONTDISCARD inline Graphics::Primitives::Camera& GetCamera() noexcept;
+	private:
+		void RenderTile(Core::GBuffer* gbuffer, const RenderSettings& settings, const Graphics::Sampling::Sampler& sampler,
+			const Graphics::Sampling::Filter& filter, const std::size_t x0, const std::size_t y0, const std::size_t x1, const std::size_t y1);
+		DONTDISCARD glm::dvec3 TraceSample(const Trace::Ray& cameraRay, Core::GBuffer* gbuffer, const std::size_t x,
+			const std::size_t y, const double normX, const double normY);
 	#pragma endregion
 
 	#pragma region //Members
 	private:
 		Graphics::Primitives::Camera mCamera;
+		Graphics::Primitives::Camera mPreviousCamera;
 		std::vector<std::shared_ptr<Composition::Object>> mObjects;
 		std::vector<std::shared_ptr<Graphics::Primitives::Lighting::Light>> mLights;
+		std::vector<std::shared_ptr<Graphics::Materials::MetalicMaterial>> mMaterials;
+		std::unordered_map<const Object*, glm::uvec2> mIds;
+		InstanceBVH mInstances;
+		Core::AccumulationBuffer mAccumulation;
+		bool mVerbose;
 	#pragma endregion
 	};
+
+	// ------------------------------------------------------------------------
+	/*! Add Object
+	*
+	*   Adds an object to the Scene, standing still since the previous frame.
+	*	Objects may share their geometry (and material) with others
+	*/ // ---------------------------------------------------------------------
+	void Scene::AddObject(const std::shared_ptr<Object>& obj) {
+		obj->AdvanceFrame();
+		mObjects.push_back(obj);
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Add Light
+	*
+	*   Adds a light to the Scene
+	*/ // ---------------------------------------------------------------------
+	void Scene::AddLight(const std::shared_ptr<Graphics::Primitives::Lighting::Light>& light) {
+		mLights.push_back(light);
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Set Verbose
+	*
+	*   Sets whether Render reports its progress on the console
+	*/ // ---------------------------------------------------------------------
+	void Scene::SetVerbose(const bool verbose) noexcept {
+		mVerbose = verbose;
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Get Camera
+	*
+	*   Returns the Camera of the Scene
+	*/ // ---------------------------------------------------------------------
+	Graphics::Primitives::Camera& Scene::GetCamera() noexcept {
+		return mCamera;
+	}
 }
 
 #endif
\ No newline at end of file
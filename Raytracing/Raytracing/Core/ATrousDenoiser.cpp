@@ -0,0 +1,225 @@
+//
+//	ATrousDenoiser.cpp
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 19/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#include "ATrousDenoiser.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
+#include <emmintrin.h>
+
+namespace Core {
+	namespace {
+		// 1D B3 spline, the kernel is its outer product
+		constexpr float cKernel[5] = { 1.f / 16.f, 1.f / 4.f, 3.f / 8.f, 1.f / 4.f, 1.f / 16.f };
+
+		// Keeps black albedo from dividing by zero when demodulating
+		constexpr float cMinAlbedo = 1e-3f;
+
+		// ------------------------------------------------------------------------
+		/*! Exp
+		*
+		*   Four lane e^x for x <= 0, splitting 2^t into an exponent and a
+		*	polynomial fit of its fraction. Relative error is below 1e-4
+		*/ // ---------------------------------------------------------------------
+		__m128 Exp(const __m128 x) noexcept {
+			const __m128 t = _mm_mul_ps(_mm_max_ps(x, _mm_set1_ps(-80.f)), _mm_set1_ps(1.44269504f));
+			__m128i integer = _mm_cvttps_epi32(t);
+			__m128 whole = _mm_cvtepi32_ps(integer);
+
+			// Truncation rounds negative values up, step back to the floor
+			const __m128 above = _mm_cmpgt_ps(whole, t);
+			whole = _mm_sub_ps(whole, _mm_and_ps(above, _mm_set1_ps(1.f)));
+			integer = _mm_sub_epi32(integer, _mm_and_si128(_mm_castps_si128(above), _mm_set1_epi32(1)));
+
+			const __m128 f = _mm_sub_ps(t, whole);
+			__m128 p = _mm_set1_ps(0.0135557f);
+
+			p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(0.0520323f));
+			p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(0.2413793f));
+			p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(0.6930321f));
+			p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(1.f));
+
+			return _mm_mul_ps(p, _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(integer, _mm_set1_epi32(127)), 23)));
+		}
+
+		// ------------------------------------------------------------------------
+		/*! Square
+		*
+		*   Four lane x * x
+		*/ // ---------------------------------------------------------------------
+		__m128 Square(const __m128 x) noexcept {
+			return _mm_mul_ps(x, x);
+		}
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Custom Constructor
+	*
+	*   Sets the number of passes and the edge stopping sigmas. The color sigma
+	*	is halved on every pass, as the image gets smoother. A thread count of 0
+	*	uses every hardware thread
+	*/ // ---------------------------------------------------------------------
+	ATrousDenoiser::ATrousDenoiser(const int iterations, const float sigmaColor, const float sigmaNormal,
+		const float sigmaDepth, const unsigned threadCount) noexcept :
+		mIterations{ std::max(iterations, 0) }, mSigmaColor{ sigmaColor }, mSigmaNormal{ sigmaNormal }, mSigmaDepth{ sigmaDepth },
+		mThreadCount{ threadCount ? threadCount : std::max(std::thread::hardware_concurrency(), 1u) } {}
+
+	// ------------------------------------------------------------------------
+	/*! Denoise
+	*
+	*   Filters the frame radiance in place. Lighting is divided by the albedo
+	*	first, so the filter never blurs surface colors, only the noise on top
+	*/ // ---------------------------------------------------------------------
+	void ATrousDenoiser::Denoise(FrameBuffer& frame, const GBuffer& gbuffer) const {
+		const std::size_t width = frame.GetWidth(), height = frame.GetHeight();
+
+		//If the GBuffer was not rendered along with the frame, its edges are meaningless
+		if (gbuffer.GetWidth() != width || gbuffer.GetHeight() != height)
+			throw ATrousDenoiserException("GBuffer does not match the frame size");
+
+		Planes planes[2];
+
+		for (Planes& buffer : planes)
+			for (std::vector<float>& plane : buffer) plane.resize(width * height);
+
+		// Demodulate the albedo
+		for (std::size_t y = 0; y < height; y++)
+			for (std::size_t x = 0; x < width; x++) {
+				const glm::vec3 radiance = frame.GetRadiance(x, y) / glm::max(gbuffer.GetAlbedo(x, y), cMinAlbedo);
+
+				for (glm::length_t c = 0; c < 3; c++) planes[0][c][y * width + x] = radiance[c];
+			}
+
+		// Every pass doubles the distance between taps, reading the result of the previous one
+		for (int i = 0; i < mIterations; i++) {
+			const Planes& input = planes[i & 1];
+			Planes& output = planes[(i + 1) & 1];
+			const float sigmaColor = mSigmaColor / static_cast<float>(1 << i);
+			std::atomic<std::size_t> nextRow{ 0 };
+			std::vector<std::thread> workers;
+
+			const auto work = [&]() {
+				for (std::size_t y = nextRow++; y < height; y = nextRow++)
+					FilterRow(input, output, gbuffer, y, 1 << i, sigmaColor);
+			};
+
+			for (unsigned t = 1; t < std::min<std::size_t>(mThreadCount, height); t++)
+				workers.emplace_back(work);
+
+			work();
+			for (std::thread& worker : workers) worker.join();
+		}
+
+		// Modulate the albedo back
+		const Planes& result = planes[mIterations & 1];
+
+		for (std::size_t y = 0; y < height; y++)
+			for (std::size_t x = 0; x < width; x++) {
+				const std::size_t index = y * width + x;
+
+				frame.SetRadiance(x, y, glm::vec3(result[0][index], result[1][index], result[2][index]) *
+					glm::max(gbuffer.GetAlbedo(x, y), cMinAlbedo));
+			}
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Filter Row
+	*
+	*   Runs one 5x5 a trous pass over a row, weighting every tap by the
+	*	kernel and by how close its color, normal and relative depth are to
+	*	the center. Pixels whose taps stay inside the image horizontally go
+	*	four at a time through SSE, the rest one at a time
+	*/ // ---------------------------------------------------------------------
+	void ATrousDenoiser::FilterRow(const Planes& input, Planes& output, const GBuffer& gbuffer, const std::size_t y,
+		const int step, const float sigmaColor) const noexcept {
+		const int width = static_cast<int>(gbuffer.GetWidth()), height = static_cast<int>(gbuffer.GetHeight());
+		const float colorFactor = -1.f / (sigmaColor * sigmaColor);
+		const float normalFactor = -1.f / (mSigmaNormal * mSigmaNormal);
+		const float depthFactor = -1.f / (mSigmaDepth * mSigmaDepth);
+		const float* normal[3] = { gbuffer.GetNormalPlane(0), gbuffer.GetNormalPlane(1), gbuffer.GetNormalPlane(2) };
+		const float* depth = gbuffer.GetDepthPlane();
+		const int row = static_cast<int>(y) * width;
+		const int border = 2 * step;
+		int x = 0;
+
+		// Filters a single pixel, skipping the taps that fall off the image
+		const auto filterPixel = [&](const int px) {
+			const int p = row + px;
+			const float depthScale = 1.f / std::max(depth[p], 1e-4f);
+			float sum[3] = { 0.f, 0.f, 0.f }, weights = 0.f;
+
+			for (int ky = 0; ky < 5; ky++) {
+				const int qy = static_cast<int>(y) + (ky - 2) * step;
+
+				if (qy < 0 || qy >= height) continue;
+
+				for (int kx = 0; kx < 5; kx++) {
+					const int qx = px + (kx - 2) * step;
+
+					if (qx < 0 || qx >= width) continue;
+
+					const int q = qy * width + qx;
+					float color = 0.f, normals = 0.f;
+
+					for (int c = 0; c < 3; c++) {
+						color += (input[c][q] - input[c][p]) * (input[c][q] - input[c][p]);
+						normals += (normal[c][q] - normal[c][p]) * (normal[c][q] - normal[c][p]);
+					}
+
+					const float depths = (depth[q] - depth[p]) * depthScale;
+					const float weight = cKernel[kx] * cKernel[ky] *
+						std::exp(color * colorFactor + normals * normalFactor + depths * depths * depthFactor);
+
+					for (int c = 0; c < 3; c++) sum[c] += input[c][q] * weight;
+					weights += weight;
+				}
+			}
+
+			// The center tap always has a positive weight
+			for (int c = 0; c < 3; c++) output[c][p] = sum[c] / weights;
+		};
+
+		for (; x < std::min(border, width); x++) filterPixel(x);
+
+		for (; x + 3 < width - border; x += 4) {
+			const int p = row + x;
+			const __m128 centerColor[3] = { _mm_loadu_ps(&input[0][p]), _mm_loadu_ps(&input[1][p]), _mm_loadu_ps(&input[2][p]) };
+			const __m128 centerNormal[3] = { _mm_loadu_ps(normal[0] + p), _mm_loadu_ps(normal[1] + p), _mm_loadu_ps(normal[2] + p) };
+			const __m128 centerDepth = _mm_loadu_ps(depth + p);
+			const __m128 depthScale = _mm_div_ps(_mm_set1_ps(1.f), _mm_max_ps(centerDepth, _mm_set1_ps(1e-4f)));
+			__m128 sum[3] = { _mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps() }, weights = _mm_setzero_ps();
+
+			for (int ky = 0; ky < 5; ky++) {
+				const int qy = static_cast<int>(y) + (ky - 2) * step;
+
+				if (qy < 0 || qy >= height) continue;
+
+				for (int kx = 0; kx < 5; kx++) {
+					const int q = qy * width + x + (kx - 2) * step;
+					const __m128 tapColor[3] = { _mm_loadu_ps(&input[0][q]), _mm_loadu_ps(&input[1][q]), _mm_loadu_ps(&input[2][q]) };
+					const __m128 color = _mm_add_ps(_mm_add_ps(Square(_mm_sub_ps(tapColor[0], centerColor[0])),
+						Square(_mm_sub_ps(tapColor[1], centerColor[1]))), Square(_mm_sub_ps(tapColor[2], centerColor[2])));
+					const __m128 normals = _mm_add_ps(_mm_add_ps(Square(_mm_sub_ps(_mm_loadu_ps(normal[0] + q), centerNormal[0])),
+						Square(_mm_sub_ps(_mm_loadu_ps(normal[1] + q), centerNormal[1]))), Square(_mm_sub_ps(_mm_loadu_ps(normal[2] + q), centerNormal[2])));
+					const __m128 depths = Square(_mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(depth + q), centerDepth), depthScale));
+					const __m128 exponent = _mm_add_ps(_mm_add_ps(_mm_mul_ps(color, _mm_set1_ps(colorFactor)),
+						_mm_mul_ps(normals, _mm_set1_ps(normalFactor))), _mm_mul_ps(depths, _mm_set1_ps(depthFactor)));
+					const __m128 weight = _mm_mul_ps(_mm_set1_ps(cKernel[kx] * cKernel[ky]), Exp(exponent));
+
+					for (int c = 0; c < 3; c++) sum[c] = _mm_add_ps(sum[c], _mm_mul_ps(tapColor[c], weight));
+					weights = _mm_add_ps(weights, weight);
+				}
+			}
+
+			for (int c = 0; c < 3; c++) _mm_storeu_ps(&output[c][p], _mm_div_ps(sum[c], weights));
+		}
+
+		for (; x < width; x++) filterPixel(x);
+	}
+}
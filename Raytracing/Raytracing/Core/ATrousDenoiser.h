@@ -0,0 +1,50 @@
+//
+//	ATrousDenoiser.h
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 19/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#ifndef _ATROUS_DENOISER__H_
+#define _ATROUS_DENOISER__H_
+
+#include <array>
+#include <vector>
+#include "FrameBuffer.h"
+#include "GBuffer.h"
+#include "../CommonDefines.h"
+
+namespace Core {
+	class ATrousDenoiser {
+	#pragma region //Declarations
+		CLASS_EXCEPTION(ATrousDenoiser)
+
+		// Three color planes, filtered back and forth between iterations
+		using Planes = std::array<std::vector<float>, 3>;
+	#pragma endregion
+
+	#pragma region //Constructors & Destructors
+	public:
+		ATrousDenoiser(const int iterations = 5, const float sigmaColor = 0.5f, const float sigmaNormal = 0.3f,
+			const float sigmaDepth = 0.05f, const unsigned threadCount = 0) noexcept;
+	#pragma endregion
+
+	#pragma region //Methods
+		void Denoise(FrameBuffer& frame, const GBuffer& gbuffer) const;
+	private:
+		void FilterRow(const Planes& input, Planes& output, const GBuffer& gbuffer, const std::size_t y,
+			const int step, const float sigmaColor) const noexcept;
+	#pragma endregion
+
+	#pragma region //Members
+		int mIterations;
+		float mSigmaColor;
+		float mSigmaNormal;
+		float mSigmaDepth;
+		unsigned mThreadCount;
+	#pragma endregion
+	};
+}
+
+#endif
@@ -0,0 +1,70 @@
+//
+//	AccumulationBuffer.cpp
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 20/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#include "AccumulationBuffer.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Core {
+	namespace {
+		// Below this luminance, noise is measured in absolute terms, so dark pixels don't eat the budget
+		constexpr float cErrorFloor = 0.05f;
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Custom Constructor
+	*
+	*   Creates an empty AccumulationBuffer with a given dimension
+	*/ // ---------------------------------------------------------------------
+	AccumulationBuffer::AccumulationBuffer(const std::size_t width, const std::size_t height) :
+		mWidth{ 0 }, mHeight{ 0 } {
+		SetSize(width, height);
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Set Size
+	*
+	*   Resizes the buffer, dropping every sample
+	*/ // ---------------------------------------------------------------------
+	void AccumulationBuffer::SetSize(const std::size_t width, const std::size_t height) {
+		mWidth = width, mHeight = height;
+		mPixels.resize(width * height);
+		Clear();
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Clear
+	*
+	*   Drops every sample
+	*/ // ---------------------------------------------------------------------
+	void AccumulationBuffer::Clear() noexcept {
+		std::fill(mPixels.begin(), mPixels.end(), Pixel{ glm::vec3(0.f), 0.f, 0.f, 0, glm::vec3(0.f), 0.f });
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Get Error
+	*
+	*   Returns the worst relative standard error of the mean luminance within
+	*	a region [x0, x1) x [y0, y1). Pixels with less than two samples can't
+	*	tell their variance, and count as infinitely noisy
+	*/ // ---------------------------------------------------------------------
+	float AccumulationBuffer::GetError(const std::size_t x0, const std::size_t y0, const std::size_t x1, const std::size_t y1) const noexcept {
+		float error = 0.f;
+
+		for (std::size_t y = y0; y < y1; y++)
+			for (std::size_t x = x0; x < x1; x++) {
+				const Pixel& pixel = mPixels[y * mWidth + x];
+
+				if (pixel.count < 2) return INFINITY;
+
+				error = std::max(error, std::sqrt(GetVariance(x, y) / pixel.count) / std::max(pixel.mean, cErrorFloor));
+			}
+
+		return error;
+	}
+}
@@ -0,0 +1,148 @@
+//
+//	AccumulationBuffer.h
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 20/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#ifndef _ACCUMULATION_BUFFER__H_
+#define _ACCUMULATION_BUFFER__H_
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include "../CommonDefines.h"
+
+namespace Core {
+	class AccumulationBuffer {
+	#pragma region //Declarations
+		// Running color sum, plus Welford's mean and squared deviations of the luminance, of
+		// the samples taken inside the pixel. Apart, the filter weighted sum of the samples around it
+		struct Pixel {
+			glm::vec3 sum;
+			float mean, deviations;
+			std::uint32_t count;
+			glm::vec3 filtered;
+			float weight;
+		};
+	#pragma endregion
+
+	#pragma region //Constructors & Destructors
+	public:
+		AccumulationBuffer(const std::size_t width, const std::size_t height);
+	#pragma endregion
+
+	#pragma region //Methods
+		void SetSize(const std::size_t width, const std::size_t height);
+		void Clear() noexcept;
+		inline void AddSample(const std::size_t x, const std::size_t y, const glm::vec3& radiance) noexcept;
+		inline void Splat(const std::size_t x, const std::size_t y, const glm::vec3& radiance, const float weight) noexcept;
+		DONTDISCARD float GetError(const std::size_t x0, const std::size_t y0, const std::size_t x1, const std::size_t y1) const noexcept;
+		DONTDISCARD inline glm::vec3 GetMean(const std::size_t x, const std::size_t y) const noexcept;
+		DONTDISCARD inline glm::vec3 GetFiltered(const std::size_t x, const std::size_t y) const noexcept;
+		DONTDISCARD inline float GetVariance(const std::size_t x, const std::size_t y) const noexcept;
+		DONTDISCARD inline std::uint32_t GetCount(const std::size_t x, const std::size_t y) const noexcept;
+		DONTDISCARD inline std::size_t GetWidth() const noexcept;
+		DONTDISCARD inline std::size_t GetHeight() const noexcept;
+	#pragma endregion
+
+	#pragma region //Members
+	private:
+		std::size_t mWidth, mHeight;
+		std::vector<Pixel> mPixels;
+	#pragma endregion
+	};
+
+	// ------------------------------------------------------------------------
+	/*! Add Sample
+	*
+	*   Adds the radiance of one more camera ray to a pixel
+	*/ // ---------------------------------------------------------------------
+	void AccumulationBuffer::AddSample(const std::size_t x, const std::size_t y, const glm::vec3& radiance) noexcept {
+		Pixel& pixel = mPixels[y * mWidth + x];
+		const float luminance = glm::dot(radiance, glm::vec3(0.2126f, 0.7152f, 0.0722f));
+		const float delta = luminance - pixel.mean;
+
+		pixel.sum += radiance;
+		pixel.count++;
+		pixel.mean += delta / pixel.count;
+		pixel.deviations += delta * (luminance - pixel.mean);
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Splat
+	*
+	*   Adds a sample to the filtered value of a pixel, with the weight the
+	*	reconstruction filter gives it at that pixel
+	*/ // ---------------------------------------------------------------------
+	void AccumulationBuffer::Splat(const std::size_t x, const std::size_t y, const glm::vec3& radiance, const float weight) noexcept {
+		Pixel& pixel = mPixels[y * mWidth + x];
+
+		pixel.filtered += radiance * weight;
+		pixel.weight += weight;
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Get Mean
+	*
+	*   Returns the average radiance of a pixel
+	*/ // ---------------------------------------------------------------------
+	glm::vec3 AccumulationBuffer::GetMean(const std::size_t x, const std::size_t y) const noexcept {
+		const Pixel& pixel = mPixels[y * mWidth + x];
+
+		return pixel.count ? pixel.sum / static_cast<float>(pixel.count) : glm::vec3(0.f);
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Get Filtered
+	*
+	*   Returns the reconstructed radiance of a pixel, or its plain average if
+	*	no sample got a positive weight
+	*/ // ---------------------------------------------------------------------
+	glm::vec3 AccumulationBuffer::GetFiltered(const std::size_t x, const std::size_t y) const noexcept {
+		const Pixel& pixel = mPixels[y * mWidth + x];
+
+		return pixel.weight > 0.f ? pixel.filtered / pixel.weight : GetMean(x, y);
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Get Variance
+	*
+	*   Returns the sample variance of the luminance of a pixel
+	*/ // ---------------------------------------------------------------------
+	float AccumulationBuffer::GetVariance(const std::size_t x, const std::size_t y) const noexcept {
+		const Pixel& pixel = mPixels[y * mWidth + x];
+
+		return pixel.count > 1 ? pixel.deviations / (pixel.count - 1) : 0.f;
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Get Count
+	*
+	*   Returns how many samples a pixel got
+	*/ // ---------------------------------------------------------------------
+	std::uint32_t AccumulationBuffer::GetCount(const std::size_t x, const std::size_t y) const noexcept {
+		return mPixels[y * mWidth + x].count;
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Get Width
+	*
+	*   Returns the Width of the AccumulationBuffer
+	*/ // ---------------------------------------------------------------------
+	std::size_t AccumulationBuffer::GetWidth() const noexcept {
+		return mWidth;
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Get Height
+	*
+	*   Returns the Height of the AccumulationBuffer
+	*/ // ---------------------------------------------------------------------
+	std::size_t AccumulationBuffer::GetHeight() const noexcept {
+		return mHeight;
+	}
+}
+
+#endif
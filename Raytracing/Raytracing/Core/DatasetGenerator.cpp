@@ -0,0 +1,201 @@
+//
+//	DatasetGenerator.cpp
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 12/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#include "DatasetGenerator.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <thread>
+#include "FrameBuffer.h"
+#include "GBuffer.h"
+#include "ShardWriter.h"
+#include "../Composition/Scene.h"
+#include "../Graphics/Sampling/BlackmanHarrisFilter.h"
+
+namespace Core {
+	// ------------------------------------------------------------------------
+	/*! Custom Constructor
+	*
+	*   Prepares a dataset, creating its image directories
+	*/ // ---------------------------------------------------------------------
+	DatasetGenerator::DatasetGenerator(const DatasetSettings& settings) :
+		mSettings{ settings } {
+		//If the high res image can't be split into whole low res pixels, the pairs would not line up
+		if (mSettings.scalingFactor < 1 || mSettings.width % mSettings.scalingFactor || mSettings.height % mSettings.scalingFactor)
+			throw DatasetGeneratorException("Image size must be a multiple of the scaling factor");
+
+		//If the crops don't fit in the image or in whole low res pixels, they can't be cut
+		if (mSettings.cropSize && (mSettings.cropSize % mSettings.scalingFactor || mSettings.cropSize > mSettings.width ||
+			mSettings.cropSize > mSettings.height || !mSettings.cropsPerSample || !mSettings.cropsPerShard))
+			throw DatasetGeneratorException("Invalid dataset crop settings");
+
+		//If the auxiliary planes were asked for along with shards, they would have nowhere to go
+		if (mSettings.cropSize && mSettings.auxiliary)
+			throw DatasetGeneratorException("Auxiliary planes are only written along with images");
+
+		// Shards live next to each other, images get a directory per resolution
+		if (mSettings.cropSize)
+			std::filesystem::create_directories(std::filesystem::path(mSettings.directory) / mSettings.split);
+		else {
+			std::filesystem::create_directories(std::filesystem::path(mSettings.directory) / mSettings.split / "hr");
+			std::filesystem::create_directories(std::filesystem::path(mSettings.directory) / mSettings.split / "lr");
+			if (mSettings.auxiliary) std::filesystem::create_directories(std::filesystem::path(mSettings.directory) / mSettings.split / "aux");
+		}
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Generate
+	*
+	*   Renders every sample and writes the manifest. Each worker owns a Scene
+	*	and a pair of FrameBuffers, and keeps grabbing the next sample until
+	*	there are none left. Sample i always gets the same scene (and crops) for
+	*	a given seed, no matter which thread renders it
+	*/ // ---------------------------------------------------------------------
+	void DatasetGenerator::Generate() {
+		const unsigned threadCount = static_cast<unsigned>(std::min<std::size_t>(mSettings.threadCount ?
+			mSettings.threadCount : std::max(std::thread::hardware_concurrency(), 1u), std::max<std::size_t>(mSettings.count, 1)));
+		const std::filesystem::path root = std::filesystem::path(mSettings.directory) / mSettings.split;
+		const std::size_t crops = mSettings.cropSize ? mSettings.count * mSettings.cropsPerSample : 0;
+		std::vector<Sample> samples(mSettings.cropSize ? 0 : mSettings.count);
+		std::vector<std::string> shards;
+		std::vector<std::thread> workers;
+		std::atomic<std::size_t> nextSample{ 0 }, done{ 0 };
+		std::atomic<bool> failed{ false };
+		std::mutex console;
+
+		// The scenes are built up front, as their materials share static state while being constructed
+		std::vector<Composition::Scene> scenes(threadCount);
+
+		// Every shard is created at its final size, so the workers only fill in records
+		for (std::size_t first = 0; first < crops; first += mSettings.cropsPerShard) {
+			char name[32];
+
+			std::snprintf(name, sizeof(name), "shard_%05zu.bin", shards.size());
+			shards.push_back((root / name).generic_string());
+			ShardWriter::Create(shards.back(), std::min(mSettings.cropsPerShard, crops - first), mSettings.cropSize,
+				mSettings.scalingFactor, mSettings.format);
+		}
+
+		const auto work = [&](Composition::Scene& scene) {
+			FrameBuffer hr(mSettings.width, mSettings.height);
+			FrameBuffer lr(mSettings.width / mSettings.scalingFactor, mSettings.height / mSettings.scalingFactor);
+			GBuffer aux(lr.GetWidth(), lr.GetHeight());
+			Composition::RenderSettings render;
+			ShardWriter writer(shards, mSettings.cropsPerShard, mSettings.cropSize, mSettings.scalingFactor, mSettings.format);
+
+			// The samples are already spread among the workers
+			render.threadCount = 1;
+			render.minSamples = render.maxSamples = std::max(mSettings.samplesPerPixel, 1u);
+			render.maxDepth = mSettings.maxDepth;
+			if (render.maxSamples > 1) render.filter = std::make_shared<Graphics::Sampling::BlackmanHarrisFilter>();
+			scene.SetVerbose(false);
+			scene.GetCamera().SetAspectRatio(static_cast<double>(mSettings.width) / static_cast<double>(mSettings.height));
+
+			for (std::size_t i = nextSample++; i < mSettings.count && !failed; i = nextSample++) {
+				std::mt19937_64 generator(mSettings.seed * 0x9E3779B97F4A7C15ull + i);
+
+				scene.Randomize(generator);
+
+				// Samples are stills, with no previous frame to move from
+				scene.AdvanceFrame();
+
+				// Both images are traced from the same scene, the low res one at its own resolution
+				hr.Clear();
+				lr.Clear();
+				scene.Render(hr, nullptr, render);
+				scene.Render(lr, mSettings.auxiliary ? &aux : nullptr, render);
+
+				try {
+					if (mSettings.cropSize) {
+						// Cut random crops on the low res pixel grid
+						std::uniform_int_distribution<std::size_t> cropX(0, (mSettings.width - mSettings.cropSize) / mSettings.scalingFactor);
+						std::uniform_int_distribution<std::size_t> cropY(0, (mSettings.height - mSettings.cropSize) / mSettings.scalingFactor);
+
+						for (std::size_t k = 0; k < mSettings.cropsPerSample; k++) {
+							const std::size_t x = cropX(generator) * mSettings.scalingFactor;
+							const std::size_t y = cropY(generator) * mSettings.scalingFactor;
+
+							writer.Write(i * mSettings.cropsPerSample + k, hr, lr, x, y);
+						}
+					} else {
+						char name[32];
+
+						std::snprintf(name, sizeof(name), "%08zu.png", i);
+						samples[i].hr = (root / "hr" / name).generic_string();
+						samples[i].lr = (root / "lr" / name).generic_string();
+
+						if (!hr.SaveToFile(samples[i].hr) || !lr.SaveToFile(samples[i].lr)) failed = true;
+
+						if (mSettings.auxiliary) {
+							std::snprintf(name, sizeof(name), "%08zu.gbuf", i);
+							samples[i].aux = (root / "aux" / name).generic_string();
+							if (!aux.SaveToFile(samples[i].aux)) failed = true;
+						}
+					}
+				} catch (const std::exception&) {
+					failed = true;
+				}
+
+				if (failed) break;
+
+				const std::size_t finished = ++done;
+
+				if (!(finished % 100) || finished == mSettings.count) {
+					std::lock_guard<std::mutex> lock(console);
+					std::cout << "Generated " << finished << " of " << mSettings.count << " samples" << std::endl;
+				}
+			}
+		};
+
+		for (unsigned i = 1; i < threadCount; i++)
+			workers.emplace_back(work, std::ref(scenes[i]));
+
+		work(scenes[0]);
+		for (std::thread& worker : workers) worker.join();
+
+		//If a sample could not be written, the manifest would point to missing data
+		if (failed) throw DatasetGeneratorException("Failed to write dataset sample");
+
+		std::vector<std::string> entries;
+
+		if (mSettings.cropSize) {
+			for (const std::string& shard : shards) entries.push_back("\"" + shard + "\"");
+			WriteManifest(mSettings.split + "_shards.json", entries);
+		} else {
+			for (const Sample& sample : samples) entries.push_back("{\"hr\": \"" + sample.hr + "\", \"lr\": \"" + sample.lr +
+				(sample.aux.empty() ? "\"}" : "\", \"aux\": \"" + sample.aux + "\"}"));
+			WriteManifest(mSettings.split + "_images.json", entries);
+		}
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Write Manifest
+	*
+	*   Writes a JSON list of entries, as read by DLSS/dataset.py. Images are
+	*	listed as {"hr", "lr"} pairs (plus "aux" if any) in "<split>_images.json",
+	*	shards by path in "<split>_shards.json"
+	*/ // ---------------------------------------------------------------------
+	void DatasetGenerator::WriteManifest(const std::string& name, const std::vector<std::string>& entries) const {
+		std::ofstream file(std::filesystem::path(mSettings.directory) / name);
+
+		//If we can't create the manifest, the dataset can't be used
+		if (!file) throw DatasetGeneratorException("Failed to write dataset manifest");
+
+		file << "[";
+
+		for (std::size_t i = 0; i < entries.size(); i++)
+			file << (i ? ", " : "") << entries[i];
+
+		file << "]";
+	}
+}
@@ -0,0 +1,68 @@
+//
+//	DatasetGenerator.h
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 12/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#ifndef _DATASET_GENERATOR__H_
+#define _DATASET_GENERATOR__H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "ShardWriter.h"
+#include "../CommonDefines.h"
+
+namespace Core {
+	// What to render: count pairs of width x height images and their low res versions.
+	// A non zero crop size packs random crops into shards instead of writing images.
+	// Auxiliary planes store the low res GBuffer next to each image pair. More than one
+	// sample per pixel antialiases both images through a Blackman-Harris filter. Paths
+	// reflect up to maxDepth times, through Russian roulette after the first bounce
+	struct DatasetSettings {
+		std::string directory;
+		std::string split = "train";
+		std::size_t count = 1000;
+		std::size_t width = 256, height = 256;
+		int scalingFactor = 2;
+		std::uint64_t seed = 0;
+		unsigned threadCount = 0;
+		std::size_t cropSize = 0;
+		std::size_t cropsPerSample = 4;
+		std::size_t cropsPerShard = 4096;
+		ShardFormat format = ShardFormat::Uint8;
+		bool auxiliary = false;
+		unsigned samplesPerPixel = 1;
+		unsigned maxDepth = 8;
+	};
+
+	class DatasetGenerator {
+	#pragma region //Declarations
+		CLASS_EXCEPTION(DatasetGenerator)
+
+		// Image files of a single rendered pair, relative to the working directory
+		struct Sample {
+			std::string hr, lr, aux;
+		};
+	#pragma endregion
+
+	#pragma region //Constructors & Destructors
+	public:
+		DatasetGenerator(const DatasetSettings& settings);
+	#pragma endregion
+
+	#pragma region //Methods
+		void Generate();
+	private:
+		void WriteManifest(const std::string& name, const std::vector<std::string>& entries) const;
+	#pragma endregion
+
+	#pragma region //Members
+		DatasetSettings mSettings;
+	#pragma endregion
+	};
+}
+
+#endif
@@ -7,6 +7,7 @@
 //
 
 #include "FrameBuffer.h"
+#include <algorithm>
 
 namespace Core {
     // ------------------------------------------------------------------------
@@ -25,13 +26,13 @@ namespace Core {
 	*   Returns the Color of a certain pixel given it's coordinates
     */ // ---------------------------------------------------------------------
     sf::Color FrameBuffer::GetColor(const std::size_t x, const std::size_t y) const noexcept {
-        std::size_t indexi = pixelIndex(x, y);
+        const std::size_t indexi = pixelIndex(x, y);
 
         return sf::Color(
-            mPixels[indexi++],
-            mPixels[indexi++],
-            mPixels[indexi++],
-            mPixels[indexi]
+            mPixels[indexi],
+            mPixels[indexi + 1],
+            mPixels[indexi + 2],
+            mPixels[indexi + 3]
         );
     }
 
@@ -49,6 +50,18 @@ namespace Core {
         mPixels[indexi] = color.a;
     }
 
+    // ------------------------------------------------------------------------
+    /*! Set Radiance
+    *
+	*   Stores the HDR color of a Pixel, and its clamped version for display
+    */ // ---------------------------------------------------------------------
+    void FrameBuffer::SetRadiance(const std::size_t x, const std::size_t y, const glm::vec3& radiance) noexcept {
+        const glm::vec3 color = glm::clamp(radiance, 0.f, 1.f) * 255.f;
+
+        mRadiance[y * mWidth + x] = radiance;
+        SetColor(x, y, sf::Color(static_cast<sf::Uint8>(color.r), static_cast<sf::Uint8>(color.g), static_cast<sf::Uint8>(color.b), 255));
+    }
+
     // ------------------------------------------------------------------------
     /*! Draw to Render Target
     *
@@ -65,22 +78,53 @@ namespace Core {
                                                 static_cast<sf::Uint8>((c.b / mGlobalMax) * 255), 255 });
             }
 
+        // The texture is only created once we draw, so headless FrameBuffers never need it
+        if (mTexture.getSize() != sf::Vector2u(static_cast<unsigned>(mWidth), static_cast<unsigned>(mHeight)))
+            mTexture.create(static_cast<unsigned>(mWidth), static_cast<unsigned>(mHeight));
+
         mTexture.update(mPixels.get());
         target.draw(sf::Sprite(mTexture), states);
     }
 
+    // ------------------------------------------------------------------------
+    /*! Save To File
+    *
+	*   Writes the Pixels to an image file, as they are and fully opaque
+    */ // ---------------------------------------------------------------------
+    bool FrameBuffer::SaveToFile(const std::string& path) const {
+        std::unique_ptr<sf::Uint8[]> pixels = std::make_unique<sf::Uint8[]>(getBufferPixelSize());
+        sf::Image image;
+
+        for (std::size_t i = 0; i < getBufferPixelSize(); i += 4) {
+            pixels[i] = mPixels[i];
+            pixels[i + 1] = mPixels[i + 1];
+            pixels[i + 2] = mPixels[i + 2];
+            pixels[i + 3] = 255;
+        }
+
+        image.create(static_cast<unsigned>(mWidth), static_cast<unsigned>(mHeight), pixels.get());
+        return image.saveToFile(path);
+    }
+
     // ------------------------------------------------------------------------
     /*! Set Size
     *
     *   Sets the Size of the new FrameBuffer
     */ // ---------------------------------------------------------------------
     void FrameBuffer::SetSize(const std::size_t width, const std::size_t height) {
-        sf::Texture newTexture;
-
         mWidth = width, mHeight = height;
-        newTexture.create(static_cast<unsigned>(mWidth), static_cast<unsigned>(mHeight));
-        mTexture = newTexture;
         mPixels = std::make_unique<sf::Uint8[]>(getBufferPixelSize());
+        mRadiance = std::make_unique<glm::vec3[]>(mWidth * mHeight);
+    }
+
+    // ------------------------------------------------------------------------
+    /*! Clear
+    *
+    *   Sets every Pixel back to transparent black, with no radiance
+    */ // ---------------------------------------------------------------------
+    void FrameBuffer::Clear() noexcept {
+        std::fill(mPixels.get(), mPixels.get() + getBufferPixelSize(), static_cast<sf::Uint8>(0));
+        std::fill(mRadiance.get(), mRadiance.get() + mWidth * mHeight, glm::vec3(0.f));
     }
 
     // ------------------------------------------------------------------------
@@ -10,7 +10,9 @@
 #define _FRAMEBUFFER__H_
 
 #include <SFML/Graphics.hpp>
+#include <glm/glm.hpp>
 #include <memory>
+#include <string>
 #include "../CommonDefines.h"
 
 namespace Core {
@@ -22,11 +24,15 @@ namespace Core {
 
     #pragma region //Methods
         void SetSize(const std::size_t width, const std::size_t height);
+        void Clear() noexcept;
         void DrawToRenderTarget(sf::RenderTarget& target, sf::RenderStates states);
+        bool SaveToFile(const std::string& path) const;
         void SetColor(const std::size_t x, const std::size_t y, const sf::Color& color) noexcept;
+        void SetRadiance(const std::size_t x, const std::size_t y, const glm::vec3& radiance) noexcept;
         DONTDISCARD inline std::size_t GetWidth() const noexcept;
         DONTDISCARD inline std::size_t GetHeight() const noexcept;
         DONTDISCARD sf::Color GetColor(const std::size_t x, const std::size_t y) const noexcept;
+        DONTDISCARD inline const glm::vec3& GetRadiance(const std::size_t x, const std::size_t y) const noexcept;
     private:
         void ComputeMaxValues();
         DONTDISCARD inline std::size_t getBufferPixelSize() const;
@@ -37,6 +43,7 @@ namespace Core {
 		double mRed, mGreen, mBlue, mGlobalMax;
         std::size_t mWidth, mHeight;
 		std::unique_ptr<sf::Uint8[]> mPixels;
+		std::unique_ptr<glm::vec3[]> mRadiance;
 		sf::Texture mTexture;
     #pragma endregion
     };
@@ -59,6 +66,15 @@ namespace Core {
         return ((y * mWidth) + x) * 4;
     }
 
+    // ------------------------------------------------------------------------
+    /*! Get Radiance
+    *
+    *   Returns the unclamped color last given to a pixel through SetRadiance
+    */ // ---------------------------------------------------------------------
+    const glm::vec3& FrameBuffer::GetRadiance(const std::size_t x, const std::size_t y) const noexcept {
+        return mRadiance[y * mWidth + x];
+    }
+
     // ------------------------------------------------------------------------
     /*! Get Width
     *
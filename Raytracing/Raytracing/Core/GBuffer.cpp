@@ -0,0 +1,94 @@
+//
+//	GBuffer.cpp
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 16/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#include "GBuffer.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace Core {
+	namespace {
+		constexpr char cMagic[4] = { 'S', 'R', 'G', 'B' };
+		constexpr std::uint32_t cVersion = 2;
+
+		// ------------------------------------------------------------------------
+		/*! Write Plane
+		*
+		*   Writes a whole plane as raw little endian values
+		*/ // ---------------------------------------------------------------------
+		template<typename T>
+		void WritePlane(std::ostream& stream, const std::vector<T>& plane) {
+			stream.write(reinterpret_cast<const char*>(plane.data()), plane.size() * sizeof(T));
+		}
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Custom Constructor
+	*
+	*   Creates a GBuffer with a given dimension
+	*/ // ---------------------------------------------------------------------
+	GBuffer::GBuffer(const std::size_t width, const std::size_t height) :
+		mWidth{ 0 }, mHeight{ 0 } {
+		SetSize(width, height);
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Set Size
+	*
+	*   Resizes every plane, clearing them
+	*/ // ---------------------------------------------------------------------
+	void GBuffer::SetSize(const std::size_t width, const std::size_t height) {
+		const std::size_t size = width * height;
+
+		mWidth = width, mHeight = height;
+		mDepth.resize(size);
+		for (auto& plane : mNormal) plane.resize(size);
+		for (auto& plane : mAlbedo) plane.resize(size);
+		for (auto& plane : mMotion) plane.resize(size);
+		mObjectId.resize(size);
+		mMaterialId.resize(size);
+		Clear();
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Clear
+	*
+	*   Marks every pixel as not hitting anything
+	*/ // ---------------------------------------------------------------------
+	void GBuffer::Clear() noexcept {
+		std::fill(mDepth.begin(), mDepth.end(), 0.f);
+		for (auto& plane : mNormal) std::fill(plane.begin(), plane.end(), 0.f);
+		for (auto& plane : mAlbedo) std::fill(plane.begin(), plane.end(), 0.f);
+		for (auto& plane : mMotion) std::fill(plane.begin(), plane.end(), 0.f);
+		std::fill(mObjectId.begin(), mObjectId.end(), 0u);
+		std::fill(mMaterialId.begin(), mMaterialId.end(), 0u);
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Save To File
+	*
+	*   Writes "SRGB", version, width and height as 32 bit integers, followed
+	*	by the float32 depth, normal xyz, albedo rgb and motion xy planes and
+	*	the uint32 object and material id planes
+	*/ // ---------------------------------------------------------------------
+	bool GBuffer::SaveToFile(const std::string& path) const {
+		std::ofstream file(path, std::ios::binary);
+		const std::uint32_t header[3] = { cVersion, static_cast<std::uint32_t>(mWidth), static_cast<std::uint32_t>(mHeight) };
+
+		file.write(cMagic, sizeof(cMagic));
+		file.write(reinterpret_cast<const char*>(header), sizeof(header));
+		WritePlane(file, mDepth);
+		for (const auto& plane : mNormal) WritePlane(file, plane);
+		for (const auto& plane : mAlbedo) WritePlane(file, plane);
+		for (const auto& plane : mMotion) WritePlane(file, plane);
+		WritePlane(file, mObjectId);
+		WritePlane(file, mMaterialId);
+
+		return static_cast<bool>(file);
+	}
+}
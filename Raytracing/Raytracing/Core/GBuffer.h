@@ -0,0 +1,217 @@
+//
+//	GBuffer.h
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 16/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#ifndef _GBUFFER__H_
+#define _GBUFFER__H_
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+#include "../CommonDefines.h"
+
+namespace Core {
+	class GBuffer {
+	#pragma region //Constructor
+	public:
+		GBuffer(const std::size_t width, const std::size_t height);
+	#pragma endregion
+
+	#pragma region //Methods
+		void SetSize(const std::size_t width, const std::size_t height);
+		void Clear() noexcept;
+		inline void SetSample(const std::size_t x, const std::size_t y, const float depth, const glm::vec3& normal,
+			const glm::vec3& albedo, const std::uint32_t objectId, const std::uint32_t materialId) noexcept;
+		inline void SetMotion(const std::size_t x, const std::size_t y, const glm::vec2& motion) noexcept;
+		bool SaveToFile(const std::string& path) const;
+		DONTDISCARD inline std::size_t GetWidth() const noexcept;
+		DONTDISCARD inline std::size_t GetHeight() const noexcept;
+		DONTDISCARD inline float GetDepth(const std::size_t x, const std::size_t y) const noexcept;
+		DONTDISCARD inline glm::vec3 GetNormal(const std::size_t x, const std::size_t y) const noexcept;
+		DONTDISCARD inline glm::vec3 GetAlbedo(const std::size_t x, const std::size_t y) const noexcept;
+		DONTDISCARD inline std::uint32_t GetObjectId(const std::size_t x, const std::size_t y) const noexcept;
+		DONTDISCARD inline std::uint32_t GetMaterialId(const std::size_t x, const std::size_t y) const noexcept;
+		DONTDISCARD inline glm::vec2 GetMotion(const std::size_t x, const std::size_t y) const noexcept;
+		DONTDISCARD inline const float* GetDepthPlane() const noexcept;
+		DONTDISCARD inline const float* GetNormalPlane(const std::size_t axis) const noexcept;
+		DONTDISCARD inline const float* GetAlbedoPlane(const std::size_t channel) const noexcept;
+		DONTDISCARD inline const float* GetMotionPlane(const std::size_t axis) const noexcept;
+	private:
+		DONTDISCARD inline std::size_t pixelIndex(const std::size_t x, const std::size_t y) const noexcept;
+	#pragma endregion
+
+	#pragma region //Members
+		std::size_t mWidth, mHeight;
+		std::vector<float> mDepth;
+		std::array<std::vector<float>, 3> mNormal;
+		std::array<std::vector<float>, 3> mAlbedo;
+		std::array<std::vector<float>, 2> mMotion;
+		std::vector<std::uint32_t> mObjectId;
+		std::vector<std::uint32_t> mMaterialId;
+	#pragma endregion
+	};
+
+	// ------------------------------------------------------------------------
+	/*! Pixel Index
+	*
+	*   Returns the index of a certain pixel within every plane
+	*/ // ---------------------------------------------------------------------
+	std::size_t GBuffer::pixelIndex(const std::size_t x, const std::size_t y) const noexcept {
+		return y * mWidth + x;
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Set Sample
+	*
+	*   Stores what the primary ray of a pixel hit
+	*/ // ---------------------------------------------------------------------
+	void GBuffer::SetSample(const std::size_t x, const std::size_t y, const float depth, const glm::vec3& normal,
+		const glm::vec3& albedo, const std::uint32_t objectId, const std::uint32_t materialId) noexcept {
+		const std::size_t index = pixelIndex(x, y);
+
+		mDepth[index] = depth;
+
+		for (glm::length_t i = 0; i < 3; i++) {
+			mNormal[i][index] = normal[i];
+			mAlbedo[i][index] = albedo[i];
+		}
+
+		mObjectId[index] = objectId;
+		mMaterialId[index] = materialId;
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Set Motion
+	*
+	*   Stores the offset, in pixels, from a pixel to where its surface was
+	*	seen on the previous frame
+	*/ // ---------------------------------------------------------------------
+	void GBuffer::SetMotion(const std::size_t x, const std::size_t y, const glm::vec2& motion) noexcept {
+		const std::size_t index = pixelIndex(x, y);
+
+		mMotion[0][index] = motion.x;
+		mMotion[1][index] = motion.y;
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Get Width
+	*
+	*   Returns the Width of the GBuffer
+	*/ // ---------------------------------------------------------------------
+	std::size_t GBuffer::GetWidth() const noexcept {
+		return mWidth;
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Get Height
+	*
+	*   Returns the Height of the GBuffer
+	*/ // ---------------------------------------------------------------------
+	std::size_t GBuffer::GetHeight() const noexcept {
+		return mHeight;
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Get Depth
+	*
+	*   Returns the linear depth along the camera axis, 0 where nothing was hit
+	*/ // ---------------------------------------------------------------------
+	float GBuffer::GetDepth(const std::size_t x, const std::size_t y) const noexcept {
+		return mDepth[pixelIndex(x, y)];
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Get Normal
+	*
+	*   Returns the world space normal of a pixel
+	*/ // ---------------------------------------------------------------------
+	glm::vec3 GBuffer::GetNormal(const std::size_t x, const std::size_t y) const noexcept {
+		const std::size_t index = pixelIndex(x, y);
+
+		return { mNormal[0][index], mNormal[1][index], mNormal[2][index] };
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Get Albedo
+	*
+	*   Returns the base color of the surface seen through a pixel
+	*/ // ---------------------------------------------------------------------
+	glm::vec3 GBuffer::GetAlbedo(const std::size_t x, const std::size_t y) const noexcept {
+		const std::size_t index = pixelIndex(x, y);
+
+		return { mAlbedo[0][index], mAlbedo[1][index], mAlbedo[2][index] };
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Get Object Id
+	*
+	*   Returns the 1 based index of the object seen through a pixel, 0 if none
+	*/ // ---------------------------------------------------------------------
+	std::uint32_t GBuffer::GetObjectId(const std::size_t x, const std::size_t y) const noexcept {
+		return mObjectId[pixelIndex(x, y)];
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Get Material Id
+	*
+	*   Returns the 1 based id of the material seen through a pixel, 0 if none
+	*/ // ---------------------------------------------------------------------
+	std::uint32_t GBuffer::GetMaterialId(const std::size_t x, const std::size_t y) const noexcept {
+		return mMaterialId[pixelIndex(x, y)];
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Get Motion
+	*
+	*   Returns the offset from a pixel to its position on the previous frame
+	*/ // ---------------------------------------------------------------------
+	glm::vec2 GBuffer::GetMotion(const std::size_t x, const std::size_t y) const noexcept {
+		const std::size_t index = pixelIndex(x, y);
+
+		return { mMotion[0][index], mMotion[1][index] };
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Get Depth Plane
+	*
+	*   Returns the row major depth plane
+	*/ // ---------------------------------------------------------------------
+	const float* GBuffer::GetDepthPlane() const noexcept {
+		return mDepth.data();
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Get Normal Plane
+	*
+	*   Returns the row major plane of one normal axis
+	*/ // ---------------------------------------------------------------------
+	const float* GBuffer::GetNormalPlane(const std::size_t axis) const noexcept {
+		return mNormal[axis].data();
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Get Albedo Plane
+	*
+	*   Returns the row major plane of one albedo channel
+	*/ // ---------------------------------------------------------------------
+	const float* GBuffer::GetAlbedoPlane(const std::size_t channel) const noexcept {
+		return mAlbedo[channel].data();
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Get Motion Plane
+	*
+	*   Returns the row major plane of one motion vector axis
+	*/ // ---------------------------------------------------------------------
+	const float* GBuffer::GetMotionPlane(const std::size_t axis) const noexcept {
+		return mMotion[axis].data();
+	}
+}
+
+#endif
@@ -0,0 +1,88 @@
+//
+//	MappedFile.cpp
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 28/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Core {
+	// ------------------------------------------------------------------------
+	/*! Custom Constructor
+	*
+	*   Maps the whole file at path. The view keeps the file open, so no
+	*	handle has to outlive the constructor
+	*/ // ---------------------------------------------------------------------
+	MappedFile::MappedFile(const std::string& path) :
+		mData{ nullptr }, mSize{ 0 } {
+#ifdef _WIN32
+		const HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+			FILE_ATTRIBUTE_NORMAL, nullptr);
+		LARGE_INTEGER size;
+
+		//If the file can't be opened, there is nothing to map
+		if (file == INVALID_HANDLE_VALUE) throw MappedFileException("Failed to open mapped file");
+
+		//If the file is empty, there is nothing to map either
+		if (!GetFileSizeEx(file, &size) || !size.QuadPart) {
+			CloseHandle(file);
+			throw MappedFileException("Failed to map empty file");
+		}
+
+		const HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+		mData = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+		mSize = static_cast<std::size_t>(size.QuadPart);
+
+		if (mapping) CloseHandle(mapping);
+		CloseHandle(file);
+#else
+		const int file = open(path.c_str(), O_RDONLY);
+		struct stat info;
+
+		//If the file can't be opened, there is nothing to map
+		if (file < 0) throw MappedFileException("Failed to open mapped file");
+
+		//If the file is empty, there is nothing to map either
+		if (fstat(file, &info) || !info.st_size) {
+			close(file);
+			throw MappedFileException("Failed to map empty file");
+		}
+
+		void* data = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_SHARED, file, 0);
+
+		mData = data == MAP_FAILED ? nullptr : data;
+		mSize = static_cast<std::size_t>(info.st_size);
+		close(file);
+#endif
+
+		//If the view couldn't be made, the file can't be read through it
+		if (!mData) throw MappedFileException("Failed to map file");
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Destructor
+	*
+	*   Unmaps the file
+	*/ // ---------------------------------------------------------------------
+	MappedFile::~MappedFile() noexcept {
+#ifdef _WIN32
+		UnmapViewOfFile(mData);
+#else
+		munmap(const_cast<void*>(mData), mSize);
+#endif
+	}
+}
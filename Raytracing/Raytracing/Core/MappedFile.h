@@ -0,0 +1,63 @@
+//
+//	MappedFile.h
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 28/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#ifndef _MAPPED_FILE__H_
+#define _MAPPED_FILE__H_
+
+#include <cstddef>
+#include <string>
+#include "../CommonDefines.h"
+
+namespace Core {
+	// Whole file mapped read only into memory. Pages are only read in when touched,
+	// and processes mapping the same file share them
+	class MappedFile {
+	#pragma region //Declarations
+	public:
+		CLASS_EXCEPTION(MappedFile)
+	#pragma endregion
+
+	#pragma region //Constructors & Destructors
+		MappedFile(const std::string& path);
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+		~MappedFile() noexcept;
+	#pragma endregion
+
+	#pragma region //Methods
+		DONTDISCARD inline const void* GetData() const noexcept;
+		DONTDISCARD inline std::size_t GetSize() const noexcept;
+	#pragma endregion
+
+	#pragma region //Members
+	private:
+		const void* mData;
+		std::size_t mSize;
+	#pragma endregion
+	};
+
+	// ------------------------------------------------------------------------
+	/*! Get Data
+	*
+	*   Returns the first byte of the file
+	*/ // ---------------------------------------------------------------------
+	const void* MappedFile::GetData() const noexcept {
+		return mData;
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Get Size
+	*
+	*   Returns the size of the file, in bytes
+	*/ // ---------------------------------------------------------------------
+	std::size_t MappedFile::GetSize() const noexcept {
+		return mSize;
+	}
+}
+
+#endif
@@ -7,15 +7,24 @@
 //
 
 #include "RaytracingApp.h"
+#include <iostream>
 
 namespace Core {
+	namespace {
+		// Exported by DLSS/export_weights.py, relative to the project directory
+		constexpr const char* cUpscalerWeights = "../../DLSS/models/SRResNetx2.bin";
+
+		// Pixels get samples until they are clean, within these bounds
+		constexpr unsigned cMinSamples = 1, cMaxSamples = 16;
+	}
+
 	// ------------------------------------------------------------------------
 	/*! Default Constructor
 	*
 	*   Constructs a RayTracing App
 	*/ // ---------------------------------------------------------------------
 	RaytracingApp::RaytracingApp()
-		: mRunning{ false }, mWindow{ sf::VideoMode(1280, 720), "Raytracing" }, mFrameBuffer({1280, 720}) {}
+		: mRunning{ false }, mWindow{ sf::VideoMode(1280, 720), "Raytracing" }, mFrameBuffer({1280, 720}), mLowResFrameBuffer({640, 360}), mGBuffer({640, 360}), mFrame{ 0 } {}
 
 	// ------------------------------------------------------------------------
 	/*! Execute
@@ -45,10 +54,14 @@ namespace Core {
 	bool RaytracingApp::Init() {
 		mRunning = true;
 		mFrameBuffer.SetSize(mWindow.getSize().x, mWindow.getSize().y);
-		mWindow.clear();
-		mScene.Render(mFrameBuffer);
-		mFrameBuffer.DrawToRenderTarget(mWindow, sf::RenderStates::Default);
-		mWindow.display();
+
+		//Try to load the upscaler, rendering at full resolution if it is not available
+		try {
+			mUpscaler = std::make_unique<Upscaling::TiledUpscaler>(cUpscalerWeights);
+		} catch (const std::exception& e) {
+			std::cout << "Upscaler disabled: " << e.what() << std::endl;
+		}
+
 		return mRunning;
 	}
 
@@ -74,13 +87,37 @@ namespace Core {
 	// ------------------------------------------------------------------------
 	/*! Render
 	*
-	*   Renders the final image to the viewport
+	*   Renders the final image to the viewport. Every frame is accumulated
+	*	over the history of the previous ones, before denoising and upscaling
 	*/ // ---------------------------------------------------------------------
 	void RaytracingApp::Render() {
-		//mWindow.clear();
-		//mScene.Render(mFrameBuffer);
-		//mFrameBuffer.DrawToRenderTarget(mWindow, sf::RenderStates::Default);
-		//mWindow.display();
+		mWindow.clear();
+
+		// Every frame draws new samples, for the accumulator to converge
+		Composition::RenderSettings settings;
+		settings.frame = mFrame++;
+		settings.minSamples = cMinSamples;
+		settings.maxSamples = cMaxSamples;
+
+		//If we can upscale, render at low resolution and let the network fill in the rest
+		if (mUpscaler) {
+			const int scale = mUpscaler->GetScalingFactor();
+			mLowResFrameBuffer.SetSize(mFrameBuffer.GetWidth() / scale, mFrameBuffer.GetHeight() / scale);
+			mScene.Render(mLowResFrameBuffer, &mGBuffer, settings);
+			mAccumulator.Accumulate(mLowResFrameBuffer, mGBuffer);
+			mDenoiser.Denoise(mLowResFrameBuffer, mGBuffer);
+			mUpscaler->Upscale(mLowResFrameBuffer, mFrameBuffer);
+		} else {
+			mScene.Render(mFrameBuffer, &mGBuffer, settings);
+			mAccumulator.Accumulate(mFrameBuffer, mGBuffer);
+			mDenoiser.Denoise(mFrameBuffer, mGBuffer);
+		}
+
+		// Whatever moves from now on is measured against this frame
+		mScene.AdvanceFrame();
+
+		mFrameBuffer.DrawToRenderTarget(mWindow, sf::RenderStates::Default);
+		mWindow.display();
 	}
 	
 	// ------------------------------------------------------------------------
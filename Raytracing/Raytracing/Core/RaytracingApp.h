@@ -10,9 +10,13 @@
 #define _RAYTRACING__APP_H_
 
 #include <SFML/Graphics.hpp>
+#include "ATrousDenoiser.h"
 #include "FrameBuffer.h"
+#include "GBuffer.h"
+#include "TemporalAccumulator.h"
 #include "../CommonDefines.h"
 #include "../Composition/Scene.h"
+#include "../Upscaling/TiledUpscaler.h"
 
 namespace Core {
 	class RaytracingApp {
@@ -39,7 +43,13 @@ namespace Core {
 		bool mRunning;
 		sf::RenderWindow mWindow;
 		FrameBuffer mFrameBuffer;
+		FrameBuffer mLowResFrameBuffer;
+		GBuffer mGBuffer;
+		TemporalAccumulator mAccumulator;
+		ATrousDenoiser mDenoiser;
+		std::unique_ptr<Upscaling::TiledUpscaler> mUpscaler;
 		Composition::Scene mScene;
+		std::uint32_t mFrame;
 	#pragma endregion
 	};
 }
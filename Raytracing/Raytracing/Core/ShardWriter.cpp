@@ -0,0 +1,129 @@
+//
+//	ShardWriter.cpp
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 14/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#include "ShardWriter.h"
+#include <cstring>
+#include <glm/gtc/packing.hpp>
+
+namespace Core {
+	namespace {
+		constexpr char cMagic[4] = { 'S', 'R', 'S', 'H' };
+		constexpr std::uint32_t cVersion = 1;
+		constexpr std::uint32_t cChannels = 3;
+		constexpr std::size_t cHeaderSize = 64;
+
+		// Fixed size header in front of the records, padded to cHeaderSize bytes
+		struct ShardHeader {
+			char magic[4];
+			std::uint32_t version;
+			std::uint32_t format;
+			std::uint32_t channels;
+			std::uint32_t cropSize;
+			std::uint32_t scalingFactor;
+			std::uint64_t count;
+		};
+
+		static_assert(sizeof(ShardHeader) <= cHeaderSize, "Shard header does not fit");
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Custom Constructor
+	*
+	*   Prepares to write crops into already created shards. Crop i goes to
+	*	shard i / cropsPerShard, so each thread can own a writer and fill its
+	*	crops in any order
+	*/ // ---------------------------------------------------------------------
+	ShardWriter::ShardWriter(const std::vector<std::string>& paths, const std::size_t cropsPerShard, const std::size_t cropSize,
+		const int scalingFactor, const ShardFormat format) :
+		mPaths{ paths }, mCropsPerShard{ cropsPerShard }, mCropSize{ cropSize }, mScalingFactor{ scalingFactor },
+		mFormat{ format }, mOpenShard{ paths.size() } {}
+
+	// ------------------------------------------------------------------------
+	/*! Create
+	*
+	*   Writes the header of a shard and grows it to hold every record, so
+	*	they can later be filled in place
+	*/ // ---------------------------------------------------------------------
+	void ShardWriter::Create(const std::string& path, const std::size_t crops, const std::size_t cropSize,
+		const int scalingFactor, const ShardFormat format) {
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		char header[cHeaderSize] = {};
+		ShardHeader info{ {}, cVersion, static_cast<std::uint32_t>(format), cChannels,
+			static_cast<std::uint32_t>(cropSize), static_cast<std::uint32_t>(scalingFactor), crops };
+
+		std::memcpy(info.magic, cMagic, sizeof(cMagic));
+		std::memcpy(header, &info, sizeof(info));
+		file.write(header, sizeof(header));
+
+		// Touch the last byte, so the whole shard exists up front
+		file.seekp(cHeaderSize + crops * GetRecordSize(cropSize, scalingFactor, format) - 1);
+		file.put('\0');
+
+		//If we couldn't make room, the records would be lost
+		if (!file) throw ShardWriterException("Failed to create dataset shard");
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Get Record Size
+	*
+	*   Returns the bytes taken by one HR crop followed by its LR crop
+	*/ // ---------------------------------------------------------------------
+	std::size_t ShardWriter::GetRecordSize(const std::size_t cropSize, const int scalingFactor, const ShardFormat format) noexcept {
+		const std::size_t lrSize = cropSize / scalingFactor;
+
+		return cChannels * (cropSize * cropSize + lrSize * lrSize) * (format == ShardFormat::Half ? 2 : 1);
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Write
+	*
+	*   Stores the HR crop at (x, y) and the matching LR crop as record crop.
+	*	x and y must lie on the low res pixel grid
+	*/ // ---------------------------------------------------------------------
+	void ShardWriter::Write(const std::size_t crop, const FrameBuffer& hr, const FrameBuffer& lr, const std::size_t x, const std::size_t y) {
+		const std::size_t shard = crop / mCropsPerShard;
+		const std::size_t recordSize = GetRecordSize(mCropSize, mScalingFactor, mFormat);
+
+		// Keep the current shard open, as crops mostly arrive in order
+		if (shard != mOpenShard) {
+			mFile.close();
+			mFile.open(mPaths[shard], std::ios::binary | std::ios::in | std::ios::out);
+			mOpenShard = shard;
+		}
+
+		mRecord.clear();
+		Store(hr, x, y, mCropSize);
+		Store(lr, x / mScalingFactor, y / mScalingFactor, mCropSize / mScalingFactor);
+
+		mFile.seekp(cHeaderSize + (crop % mCropsPerShard) * recordSize);
+		mFile.write(mRecord.data(), mRecord.size());
+
+		//If the record didn't make it to disk, the shard is incomplete
+		if (!mFile) throw ShardWriterException("Failed to write dataset shard");
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Store
+	*
+	*   Appends a square crop to the record, in planar (C, H, W) order. Half
+	*	floats keep the radiance clamped to [0, 1], rather than its bytes
+	*/ // ---------------------------------------------------------------------
+	void ShardWriter::Store(const FrameBuffer& fb, const std::size_t x, const std::size_t y, const std::size_t size) {
+		for (std::uint32_t c = 0; c < cChannels; c++)
+			for (std::size_t j = y; j < y + size; j++)
+				for (std::size_t i = x; i < x + size; i++)
+					if (mFormat == ShardFormat::Half) {
+						const glm::uint16 half = glm::packHalf1x16(glm::clamp(fb.GetRadiance(i, j)[c], 0.f, 1.f));
+						mRecord.push_back(static_cast<char>(half & 0xFF));
+						mRecord.push_back(static_cast<char>(half >> 8));
+					} else {
+						const sf::Color color = fb.GetColor(i, j);
+						mRecord.push_back(static_cast<char>(c == 0 ? color.r : c == 1 ? color.g : color.b));
+					}
+	}
+}
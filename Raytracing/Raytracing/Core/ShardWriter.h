@@ -0,0 +1,58 @@
+//
+//	ShardWriter.h
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 14/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#ifndef _SHARD_WRITER__H_
+#define _SHARD_WRITER__H_
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "FrameBuffer.h"
+#include "../CommonDefines.h"
+
+namespace Core {
+	// How crop pixels are stored: bytes in [0, 255], or half floats in [0, 1]
+	enum class ShardFormat : std::uint32_t {
+		Uint8 = 0,
+		Half = 1
+	};
+
+	class ShardWriter {
+	#pragma region //Declarations
+		CLASS_EXCEPTION(ShardWriter)
+	#pragma endregion
+
+	#pragma region //Constructors & Destructors
+	public:
+		ShardWriter(const std::vector<std::string>& paths, const std::size_t cropsPerShard, const std::size_t cropSize,
+			const int scalingFactor, const ShardFormat format);
+	#pragma endregion
+
+	#pragma region //Methods
+		static void Create(const std::string& path, const std::size_t crops, const std::size_t cropSize,
+			const int scalingFactor, const ShardFormat format);
+		void Write(const std::size_t crop, const FrameBuffer& hr, const FrameBuffer& lr, const std::size_t x, const std::size_t y);
+		DONTDISCARD static std::size_t GetRecordSize(const std::size_t cropSize, const int scalingFactor, const ShardFormat format) noexcept;
+	private:
+		void Store(const FrameBuffer& fb, const std::size_t x, const std::size_t y, const std::size_t size);
+	#pragma endregion
+
+	#pragma region //Members
+		std::vector<std::string> mPaths;
+		std::size_t mCropsPerShard, mCropSize;
+		int mScalingFactor;
+		ShardFormat mFormat;
+		std::fstream mFile;
+		std::size_t mOpenShard;
+		std::vector<char> mRecord;
+	#pragma endregion
+	};
+}
+
+#endif
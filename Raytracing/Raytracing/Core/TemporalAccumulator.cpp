@@ -0,0 +1,157 @@
+//
+//	TemporalAccumulator.cpp
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 18/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#include "TemporalAccumulator.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Core {
+	namespace {
+		// Pixels moving less than this are considered still
+		constexpr float cStillMotion = 1e-3f;
+
+		// How many standard deviations of the current neighbourhood the history may stray
+		constexpr float cMovingGamma = 1.f;
+		constexpr float cStillGamma = 3.f;
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Custom Constructor
+	*
+	*   Creates an empty history. Pixels average at most maxHistory frames, and
+	*	history whose depth is off by more than depthTolerance (relative) is
+	*	treated as disoccluded
+	*/ // ---------------------------------------------------------------------
+	TemporalAccumulator::TemporalAccumulator(const unsigned maxHistory, const float depthTolerance) noexcept :
+		mWidth{ 0 }, mHeight{ 0 }, mMaxHistory{ std::max(maxHistory, 1u) }, mDepthTolerance{ depthTolerance } {}
+
+	// ------------------------------------------------------------------------
+	/*! Reset
+	*
+	*   Drops the history, so the next frame is taken as is
+	*/ // ---------------------------------------------------------------------
+	void TemporalAccumulator::Reset() noexcept {
+		mWidth = 0, mHeight = 0;
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Accumulate
+	*
+	*   Blends the radiance of a new frame with the history reprojected through
+	*	the GBuffer motion vectors, writing the result back into the frame. The
+	*	history is clipped to the variance of the new 3x3 neighbourhood, and
+	*	dropped where depth or object id show it belongs to another surface
+	*/ // ---------------------------------------------------------------------
+	void TemporalAccumulator::Accumulate(FrameBuffer& frame, const GBuffer& gbuffer) {
+		const std::size_t width = frame.GetWidth(), height = frame.GetHeight();
+
+		//If the GBuffer was not rendered along with the frame, we can't reproject it
+		if (gbuffer.GetWidth() != width || gbuffer.GetHeight() != height)
+			throw TemporalAccumulatorException("GBuffer does not match the frame size");
+
+		const bool hasHistory = mWidth == width && mHeight == height;
+		std::vector<float> length(width * height);
+
+		mResolved.resize(width * height);
+
+		for (std::size_t y = 0; y < height; y++)
+			for (std::size_t x = 0; x < width; x++) {
+				const std::size_t index = y * width + x;
+				const glm::vec3 current = frame.GetRadiance(x, y);
+				const glm::vec2 motion = gbuffer.GetMotion(x, y);
+				glm::vec3 history;
+				float previous;
+
+				//If there is no matching history, start over from this frame
+				if (!hasHistory || !FetchHistory(glm::vec2(x, y) + motion, gbuffer.GetDepth(x, y), gbuffer.GetObjectId(x, y), history, previous)) {
+					mResolved[index] = current;
+					length[index] = 1.f;
+					continue;
+				}
+
+				// Clip the history to the neighbourhood mean and deviation, so stale shading can't linger
+				glm::vec3 mean(0.f), squares(0.f);
+				float samples = 0.f;
+
+				for (std::size_t ny = y ? y - 1 : 0; ny <= std::min(y + 1, height - 1); ny++)
+					for (std::size_t nx = x ? x - 1 : 0; nx <= std::min(x + 1, width - 1); nx++) {
+						const glm::vec3& neighbour = frame.GetRadiance(nx, ny);
+
+						mean += neighbour;
+						squares += neighbour * neighbour;
+						samples++;
+					}
+
+				mean /= samples;
+
+				const float gamma = glm::length(motion) < cStillMotion ? cStillGamma : cMovingGamma;
+				const glm::vec3 deviation = glm::sqrt(glm::max(squares / samples - mean * mean, 0.f)) * gamma;
+
+				history = glm::clamp(history, mean - deviation, mean + deviation);
+				length[index] = std::min(previous + 1.f, static_cast<float>(mMaxHistory));
+				mResolved[index] = glm::mix(history, current, 1.f / length[index]);
+			}
+
+		// Only now can the frame be overwritten, as every pixel reads its neighbours
+		for (std::size_t y = 0; y < height; y++)
+			for (std::size_t x = 0; x < width; x++)
+				frame.SetRadiance(x, y, mResolved[y * width + x]);
+
+		mWidth = width, mHeight = height;
+		mColor.swap(mResolved);
+		mLength.swap(length);
+		mDepth.assign(gbuffer.GetDepthPlane(), gbuffer.GetDepthPlane() + width * height);
+		mObjectId.resize(width * height);
+
+		for (std::size_t y = 0; y < height; y++)
+			for (std::size_t x = 0; x < width; x++)
+				mObjectId[y * width + x] = gbuffer.GetObjectId(x, y);
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Fetch History
+	*
+	*   Bilinearly samples the history at a pixel position, only using the
+	*	texels that saw the same object at a similar depth. Fails if none did
+	*/ // ---------------------------------------------------------------------
+	bool TemporalAccumulator::FetchHistory(const glm::vec2& position, const float depth, const std::uint32_t objectId,
+		glm::vec3& color, float& length) const noexcept {
+		const float fx = std::floor(position.x), fy = std::floor(position.y);
+		const float wx = position.x - fx, wy = position.y - fy;
+		float weights = 0.f;
+
+		color = glm::vec3(0.f);
+		length = 0.f;
+
+		for (int ty = 0; ty < 2; ty++)
+			for (int tx = 0; tx < 2; tx++) {
+				const float hx = fx + tx, hy = fy + ty;
+
+				//If the texel is off screen, it has no history
+				if (hx < 0.f || hy < 0.f || hx >= mWidth || hy >= mHeight) continue;
+
+				const std::size_t index = static_cast<std::size_t>(hy) * mWidth + static_cast<std::size_t>(hx);
+
+				//If the texel saw something else, it was disoccluded
+				if (mObjectId[index] != objectId || std::abs(mDepth[index] - depth) > mDepthTolerance * depth) continue;
+
+				const float weight = (tx ? wx : 1.f - wx) * (ty ? wy : 1.f - wy);
+
+				color += mColor[index] * weight;
+				length += mLength[index] * weight;
+				weights += weight;
+			}
+
+		//If no texel could be used (or only with a negligible weight), there is no history
+		if (weights < 1e-4f) return false;
+
+		color /= weights;
+		length /= weights;
+		return true;
+	}
+}
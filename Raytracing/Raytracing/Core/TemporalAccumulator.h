@@ -0,0 +1,51 @@
+//
+//	TemporalAccumulator.h
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 18/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#ifndef _TEMPORAL_ACCUMULATOR__H_
+#define _TEMPORAL_ACCUMULATOR__H_
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include "FrameBuffer.h"
+#include "GBuffer.h"
+#include "../CommonDefines.h"
+
+namespace Core {
+	class TemporalAccumulator {
+	#pragma region //Declarations
+		CLASS_EXCEPTION(TemporalAccumulator)
+	#pragma endregion
+
+	#pragma region //Constructors & Destructors
+	public:
+		TemporalAccumulator(const unsigned maxHistory = 32, const float depthTolerance = 0.1f) noexcept;
+	#pragma endregion
+
+	#pragma region //Methods
+		void Accumulate(FrameBuffer& frame, const GBuffer& gbuffer);
+		void Reset() noexcept;
+	private:
+		DONTDISCARD bool FetchHistory(const glm::vec2& position, const float depth, const std::uint32_t objectId,
+			glm::vec3& color, float& length) const noexcept;
+	#pragma endregion
+
+	#pragma region //Members
+		std::size_t mWidth, mHeight;
+		unsigned mMaxHistory;
+		float mDepthTolerance;
+		std::vector<glm::vec3> mColor;
+		std::vector<glm::vec3> mResolved;
+		std::vector<float> mDepth;
+		std::vector<float> mLength;
+		std::vector<std::uint32_t> mObjectId;
+	#pragma endregion
+	};
+}
+
+#endif
@@ -7,6 +7,7 @@
 //
 
 #include "MetalicMaterial.h"
+#include "../../Composition/InstanceBVH.h"
 
 namespace Graphics {
 	namespace Materials {
@@ -17,7 +18,6 @@ namespace Graphics {
 		*/ // ---------------------------------------------------------------------
 		MetalicMaterial::MetalicMaterial() noexcept : mColor{ 0.0f } {
 			mReflectionRayCount = 0;
-			mReflectionCountMax = 1;
 			mShininess = 0.f;
 			mReflectivity = 0.f;
 		}
@@ -48,9 +48,14 @@ namespace Graphics {
 			// Compute the diffuse component.
 			difColor = ComputeColorDiffuse(objList, lightList, currObject, intersectionPoint, normalPoint, mColor);
 
-			// Compute the reflection component.
-			if (mReflectivity > 0.0)
+			// Compute the reflection component, which only carries on a share of the path
+			if (mReflectivity > 0.0) {
+				const glm::dvec3 throughput = mThroughput;
+
+				mThroughput *= mReflectivity;
 				refColor = ComputeColorReflection(objList, lightList, currObject, intersectionPoint, normalPoint, camRay);
+				mThroughput = throughput;
+			}
 
 			// Combine reflection and diffuse components.
 			matColor = (refColor * mReflectivity) + (difColor * (1 - mReflectivity));
@@ -101,7 +106,9 @@ namespace Graphics {
 				glm::dvec3 poiNormal = glm::dvec3();;
 				glm::dvec3 poiColor = glm::dvec3();;
 				bool validInt = false;
-				for (auto sceneObject : objList)
+				if (const Composition::InstanceBVH* instances = Composition::InstanceBVH::GetActive())
+					validInt = instances->IsOccluded(lightRay, nullptr, std::numeric_limits<double>::max());
+				else for (auto sceneObject : objList)
 				{
 					validInt = sceneObject->TestIntersection(lightRay, poi, poiNormal, poiColor);
 					if (validInt)
@@ -137,6 +144,9 @@ namespace Graphics {
 			spcColor.z = blue;
 			return spcColor;
 		}
+		glm::dvec3 MetalicMaterial::GetColor() const noexcept {
+			return mColor;
+		}
 		void MetalicMaterial::SetColor(const glm::dvec3& color) noexcept {
 			mColor = color;
 		}
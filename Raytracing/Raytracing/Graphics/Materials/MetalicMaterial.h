@@ -33,6 +33,7 @@ namespace Graphics {
 				const std::shared_ptr<Composition::Object>& currObject,
 				const glm::dvec3& intersectionPoint, const glm::dvec3& normalPoint,
 				const Trace::Ray& camRay) const noexcept;
+			DONTDISCARD glm::dvec3 GetColor() const noexcept override;
 			void SetColor(const glm::dvec3& color) noexcept;
 			void SetShininess(double shininess) noexcept;
 			void SetReflectivity(double reflectivity) noexcept;
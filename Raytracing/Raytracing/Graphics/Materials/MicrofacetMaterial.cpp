@@ -0,0 +1,320 @@
+//
+//	MicrofacetMaterial.cpp
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 24/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#include "MicrofacetMaterial.h"
+#include <algorithm>
+#include <cmath>
+#include <glm/gtc/constants.hpp>
+#include "../Primitives/Lighting/Light.h"
+#include "../Sampling/SampleContext.h"
+
+namespace Graphics {
+	namespace Materials {
+		namespace {
+			constexpr double cMinAlpha = 1e-3;
+			constexpr std::size_t cTableSamples = 16;
+
+			// ------------------------------------------------------------------------
+			/*! Distribution
+			*
+			*   GGX density of microfacet normals at the given cos(theta) from the normal
+			*/ // ---------------------------------------------------------------------
+			double Distribution(const double cosine, const double alpha) noexcept {
+				const double a2 = alpha * alpha;
+				const double d = (cosine * cosine * (a2 - 1.0)) + 1.0;
+
+				return a2 / (glm::pi<double>() * d * d);
+			}
+
+			// ------------------------------------------------------------------------
+			/*! Lambda
+			*
+			*   Smith's GGX auxiliary function, shared by both masking terms
+			*/ // ---------------------------------------------------------------------
+			double Lambda(const double cosine, const double alpha) noexcept {
+				const double cos2 = cosine * cosine;
+
+				return (std::sqrt(1.0 + (alpha * alpha * (1.0 - cos2) / cos2)) - 1.0) * 0.5;
+			}
+
+			// ------------------------------------------------------------------------
+			/*! Sample Visible Normal
+			*
+			*   Picks a microfacet normal as seen from the view direction, given in
+			*	the local frame of the surface (Heitz, 2018). Reflecting about it
+			*	never picks directions the microsurface hides from the viewer
+			*/ // ---------------------------------------------------------------------
+			glm::dvec3 SampleVisibleNormal(const glm::dvec3& view, const double alpha, const glm::dvec2& u) noexcept {
+				// Stretch the view into the configuration of a hemisphere
+				const glm::dvec3 vh = glm::normalize(glm::dvec3(alpha * view.x, alpha * view.y, view.z));
+				const double lensq = (vh.x * vh.x) + (vh.y * vh.y);
+				const glm::dvec3 t1 = lensq > 0.0 ? glm::dvec3(-vh.y, vh.x, 0.0) / std::sqrt(lensq) : glm::dvec3(1.0, 0.0, 0.0);
+				const glm::dvec3 t2 = glm::cross(vh, t1);
+
+				// Point on the projected hemisphere, squashed where the hemisphere is hidden
+				const double r = std::sqrt(u.x), phi = glm::two_pi<double>() * u.y;
+				const double p1 = r * std::cos(phi);
+				const double s = 0.5 * (1.0 + vh.z);
+				const double p2 = ((1.0 - s) * std::sqrt(std::max(1.0 - (p1 * p1), 0.0))) + (s * r * std::sin(phi));
+				const glm::dvec3 nh = (t1 * p1) + (t2 * p2) + (vh * std::sqrt(std::max(1.0 - (p1 * p1) - (p2 * p2), 0.0)));
+
+				// Unstretch back onto the ellipsoid
+				return glm::normalize(glm::dvec3(alpha * nh.x, alpha * nh.y, std::max(nh.z, 0.0)));
+			}
+
+			// ------------------------------------------------------------------------
+			/*! Fresnel
+			*
+			*   Schlick's approximation of the Fresnel reflectance
+			*/ // ---------------------------------------------------------------------
+			glm::dvec3 Fresnel(const glm::dvec3& f0, const double cosine) noexcept {
+				const double m = std::clamp(1.0 - cosine, 0.0, 1.0);
+				const double m2 = m * m;
+
+				return f0 + ((glm::dvec3(1.0) - f0) * (m2 * m2 * m));
+			}
+
+			// Both lobes as seen from one view, for area lights to sample and weigh.
+			// The specular lobe picks visible normals, the diffuse one cosine weighted
+			// directions, each with the chance of its share of the reflected energy
+			struct Lobes final : Primitives::Lighting::Light::Reflectance {
+				glm::dvec3 normal, tangent, bitangent, view, local, f0, compensation, diffuse;
+				double alpha, cosView, lambdaView, specularChance;
+
+				// ------------------------------------------------------------------------
+				/*! Evaluate
+				*
+				*   Returns the BSDF towards a direction, and the pdf of sampling it
+				*/ // ---------------------------------------------------------------------
+				DONTDISCARD glm::dvec3 Evaluate(const glm::dvec3& direction, double& pdf) const noexcept override {
+					const double cosLight = glm::dot(normal, direction);
+
+					pdf = 0.0;
+
+					//If the direction points into the surface, nothing is reflected along it
+					if (cosLight <= 0.0) return glm::dvec3(0.0);
+
+					const glm::dvec3 half = glm::normalize(view + direction);
+					const double d = Distribution(glm::dot(normal, half), alpha);
+					const double g2 = 1.0 / (1.0 + lambdaView + Lambda(cosLight, alpha));
+
+					pdf = (specularChance * d / (4.0 * cosView * (1.0 + lambdaView))) + ((1.0 - specularChance) * cosLight / glm::pi<double>());
+					return (diffuse / glm::pi<double>()) + (Fresnel(f0, glm::dot(view, half)) * compensation * (d * g2 / (4.0 * cosView * cosLight)));
+				}
+
+				// ------------------------------------------------------------------------
+				/*! Sample
+				*
+				*   Picks a direction from one of the lobes, returning whether it leaves
+				*	the surface
+				*/ // ---------------------------------------------------------------------
+				DONTDISCARD bool Sample(const glm::dvec2& u, glm::dvec3& direction) const noexcept override {
+					if (u.x < specularChance) {
+						const glm::dvec3 micro = SampleVisibleNormal(local, alpha, { u.x / specularChance, u.y });
+
+						direction = glm::reflect(-view, (tangent * micro.x) + (bitangent * micro.y) + (normal * micro.z));
+					} else {
+						const double x = (u.x - specularChance) / (1.0 - specularChance);
+						const double r = std::sqrt(x), phi = glm::two_pi<double>() * u.y;
+
+						direction = (tangent * (r * std::cos(phi))) + (bitangent * (r * std::sin(phi))) + (normal * std::sqrt(std::max(1.0 - x, 0.0)));
+					}
+
+					return glm::dot(normal, direction) > 0.0;
+				}
+			};
+		}
+
+		// ------------------------------------------------------------------------
+		/*! Default Constructor
+		*
+		*   Constructs a white, moderately rough conductor
+		*/ // ---------------------------------------------------------------------
+		MicrofacetMaterial::MicrofacetMaterial() :
+			mType{ Type::Conductor }, mRoughness{ 0.5 }, mIOR{ 1.5 }, mEnergy{ GetEnergyTable() } {
+			mColor = glm::dvec3(1.0);
+		}
+
+		// ------------------------------------------------------------------------
+		/*! Destructor
+		*
+		*   Destroys the Microfacet Material
+		*/ // ---------------------------------------------------------------------
+		MicrofacetMaterial::~MicrofacetMaterial() noexcept {}
+
+		// ------------------------------------------------------------------------
+		/*! Compute Color
+		*
+		*   Computes the color of the object. Lights weigh their own samples by the
+		*	lobes (area ones pairing them with samples of the lobes), the rest of
+		*	the scene is gathered through a single reflected ray, whose
+		*	microfacet is importance sampled from the visible normals. The energy
+		*	single scattering loses on rough surfaces is added back from the
+		*	directional albedo table (Turquin, 2019)
+		*/ // ---------------------------------------------------------------------
+		glm::dvec3 MicrofacetMaterial::ComputeColor(const std::vector<std::shared_ptr<Composition::Object>>& objList,
+			const std::vector<std::shared_ptr<Primitives::Lighting::Light>>& lightList,
+			const std::shared_ptr<Composition::Object>& currObject,
+			const glm::dvec3& intersectionPoint, const glm::dvec3& normalPoint,
+			const Trace::Ray& camRay) const noexcept {
+			const glm::dvec3 view = glm::normalize(camRay.GetOrigin() - camRay.GetEndPoint());
+			const double alpha = std::max(mRoughness * mRoughness, cMinAlpha);
+			const glm::dvec3 f0 = mType == Type::Conductor ? mColor : glm::dvec3(((mIOR - 1.0) / (mIOR + 1.0)) * ((mIOR - 1.0) / (mIOR + 1.0)));
+			glm::dvec3 normal = glm::normalize(normalPoint);
+
+			// Surfaces seen from behind are shaded as their front
+			if (glm::dot(normal, view) < 0.0) normal = -normal;
+
+			// Orthonormal basis around the normal (Duff et al.)
+			const double sign = std::copysign(1.0, normal.z);
+			const double a = -1.0 / (sign + normal.z);
+			const double b = normal.x * normal.y * a;
+			Lobes lobes;
+
+			lobes.normal = normal;
+			lobes.tangent = glm::dvec3(1.0 + sign * normal.x * normal.x * a, sign * b, -sign * normal.x);
+			lobes.bitangent = glm::dvec3(b, sign + normal.y * normal.y * a, -normal.y);
+			lobes.view = view;
+			lobes.alpha = alpha;
+			lobes.f0 = f0;
+			lobes.cosView = std::max(glm::dot(normal, view), 1e-6);
+			lobes.lambdaView = Lambda(lobes.cosView, alpha);
+			lobes.local = glm::dvec3(glm::dot(view, lobes.tangent), glm::dot(view, lobes.bitangent), lobes.cosView);
+			lobes.compensation = glm::dvec3(1.0) + (f0 * (1.0 / GetDirectionalAlbedo(lobes.cosView, mRoughness) - 1.0));
+			lobes.diffuse = mType == Type::Dielectric ? mColor * (glm::dvec3(1.0) - Fresnel(f0, lobes.cosView)) : glm::dvec3(0.0);
+
+			// The lobes are sampled by how much of the energy each of them reflects
+			const double specular = glm::dot(Fresnel(f0, lobes.cosView) * lobes.compensation, glm::dvec3(1.0));
+			lobes.specularChance = specular > 0.0 ? specular / (specular + glm::dot(lobes.diffuse, glm::dvec3(1.0))) : 0.0;
+
+			glm::dvec3 matColor = glm::dvec3(0.0);
+
+			// Direct lighting
+			for (auto& currentLight : lightList) {
+				glm::dvec3 radiance;
+
+				if (currentLight->ComputeReflection(intersectionPoint, normal, objList, currObject, lobes, radiance))
+					matColor += radiance;
+			}
+
+			// Reflected light, through a visible microfacet
+			const glm::dvec3 micro = SampleVisibleNormal(lobes.local, alpha, Sampling::SampleContext::Next2D());
+			const glm::dvec3 half = (lobes.tangent * micro.x) + (lobes.bitangent * micro.y) + (normal * micro.z);
+			const glm::dvec3 reflected = glm::reflect(-view, half);
+			const double cosReflected = glm::dot(normal, reflected);
+
+			//If the reflection points into the surface, it is masked away
+			if (cosReflected > 0.0) {
+				// The VNDF pdf cancels out with everything but the Fresnel and the masking G2 / G1
+				const glm::dvec3 weight = Fresnel(f0, glm::dot(view, half)) * lobes.compensation *
+					((1.0 + lobes.lambdaView) / (1.0 + lobes.lambdaView + Lambda(cosReflected, alpha)));
+				const glm::dvec3 throughput = mThroughput;
+
+				mThroughput *= weight;
+				matColor += weight * ComputeColorAlong(objList, lightList, Trace::Ray(intersectionPoint, intersectionPoint + reflected));
+				mThroughput = throughput;
+			}
+
+			return matColor;
+		}
+
+		// ------------------------------------------------------------------------
+		/*! Set Color
+		*
+		*   Sets the reflectance at normal incidence of conductors, or the
+		*	diffuse color under the coating of dielectrics
+		*/ // ---------------------------------------------------------------------
+		void MicrofacetMaterial::SetColor(const glm::dvec3& color) noexcept {
+			mColor = color;
+		}
+
+		// ------------------------------------------------------------------------
+		/*! Set Roughness
+		*
+		*   Sets the perceptual roughness, in [0, 1]. GGX's alpha is its square
+		*/ // ---------------------------------------------------------------------
+		void MicrofacetMaterial::SetRoughness(const double roughness) noexcept {
+			mRoughness = std::clamp(roughness, 0.0, 1.0);
+		}
+
+		// ------------------------------------------------------------------------
+		/*! Set Type
+		*
+		*   Sets whether the Material is a conductor or a dielectric
+		*/ // ---------------------------------------------------------------------
+		void MicrofacetMaterial::SetType(const Type type) noexcept {
+			mType = type;
+		}
+
+		// ------------------------------------------------------------------------
+		/*! Set IOR
+		*
+		*   Sets the index of refraction of dielectrics
+		*/ // ---------------------------------------------------------------------
+		void MicrofacetMaterial::SetIOR(const double ior) noexcept {
+			mIOR = ior;
+		}
+
+		// ------------------------------------------------------------------------
+		/*! Get Directional Albedo
+		*
+		*   Returns the share of the energy a white lobe reflects when lit from the
+		*	given cos(theta), interpolated from the table
+		*/ // ---------------------------------------------------------------------
+		double MicrofacetMaterial::GetDirectionalAlbedo(const double cosine, const double roughness) const noexcept {
+			const double x = std::clamp(cosine * cTableSize - 0.5, 0.0, cTableSize - 1.0);
+			const double y = std::clamp(roughness * cTableSize - 0.5, 0.0, cTableSize - 1.0);
+			const std::size_t x0 = static_cast<std::size_t>(x), y0 = static_cast<std::size_t>(y);
+			const std::size_t x1 = std::min(x0 + 1, cTableSize - 1), y1 = std::min(y0 + 1, cTableSize - 1);
+			const double fx = x - x0, fy = y - y0;
+			const double top = (mEnergy[y0 * cTableSize + x0] * (1.0 - fx)) + (mEnergy[y0 * cTableSize + x1] * fx);
+			const double bottom = (mEnergy[y1 * cTableSize + x0] * (1.0 - fx)) + (mEnergy[y1 * cTableSize + x1] * fx);
+
+			return (top * (1.0 - fy)) + (bottom * fy);
+		}
+
+		// ------------------------------------------------------------------------
+		/*! Get Energy Table
+		*
+		*   Returns the directional albedo of the GGX lobe with a Fresnel of 1, by
+		*	roughness (rows) and cos(theta) (columns). It only depends on the lobe,
+		*	so it is integrated once and shared by every Material
+		*/ // ---------------------------------------------------------------------
+		const std::vector<float>& MicrofacetMaterial::GetEnergyTable() {
+			static const std::vector<float> table = []() {
+				std::vector<float> energy(cTableSize * cTableSize);
+
+				for (std::size_t j = 0; j < cTableSize; j++)
+					for (std::size_t i = 0; i < cTableSize; i++) {
+						const double cosine = (i + 0.5) / cTableSize;
+						const double roughness = (j + 0.5) / cTableSize;
+						const double alpha = std::max(roughness * roughness, cMinAlpha);
+						const glm::dvec3 view(std::sqrt(1.0 - (cosine * cosine)), 0.0, cosine);
+						const double lambdaView = Lambda(cosine, alpha);
+						double sum = 0.0;
+
+						// Stratified visible normals, weighted by G2 / G1 like the reflected rays
+						for (std::size_t sy = 0; sy < cTableSamples; sy++)
+							for (std::size_t sx = 0; sx < cTableSamples; sx++) {
+								const glm::dvec3 half = SampleVisibleNormal(view, alpha, { (sx + 0.5) / cTableSamples, (sy + 0.5) / cTableSamples });
+								const glm::dvec3 reflected = glm::reflect(-view, half);
+
+								if (reflected.z > 0.0)
+									sum += (1.0 + lambdaView) / (1.0 + lambdaView + Lambda(reflected.z, alpha));
+							}
+
+						energy[j * cTableSize + i] = static_cast<float>(sum / (cTableSamples * cTableSamples));
+					}
+
+				return energy;
+			}();
+
+			return table;
+		}
+	}
+}
@@ -0,0 +1,62 @@
+//
+//	MicrofacetMaterial.h
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 24/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#ifndef _MICROFACET_MATERIAL__H_
+#define _MICROFACET_MATERIAL__H_
+
+#include <vector>
+#include "../Primitives/Material.h"
+
+namespace Graphics {
+	namespace Materials {
+		class MicrofacetMaterial : public Primitives::Material {
+#pragma region //Declarations
+		public:
+			// Conductors tint their reflections with the color, dielectrics reflect
+			// untinted light over a diffuse base of that color
+			enum class Type {
+				Conductor,
+				Dielectric
+			};
+
+			// Resolution of the energy compensation table, over cos(theta) and roughness
+			static constexpr std::size_t cTableSize = 32;
+#pragma endregion
+
+#pragma region //Constructors & Destructors
+			MicrofacetMaterial();
+			virtual ~MicrofacetMaterial() noexcept;
+#pragma endregion
+
+#pragma region //Methods
+			DONTDISCARD glm::dvec3 ComputeColor(
+				const std::vector<std::shared_ptr<Composition::Object>>& objList,
+				const std::vector<std::shared_ptr<Primitives::Lighting::Light>>& lightList,
+				const std::shared_ptr<Composition::Object>& currObject,
+				const glm::dvec3& intersectionPoint, const glm::dvec3& normalPoint,
+				const Trace::Ray& camRay) const noexcept override;
+			void SetColor(const glm::dvec3& color) noexcept;
+			void SetRoughness(const double roughness) noexcept;
+			void SetType(const Type type) noexcept;
+			void SetIOR(const double ior) noexcept;
+		private:
+			DONTDISCARD double GetDirectionalAlbedo(const double cosine, const double roughness) const noexcept;
+			DONTDISCARD static const std::vector<float>& GetEnergyTable();
+#pragma endregion
+
+#pragma region //Members
+			Type mType;
+			double mRoughness;
+			double mIOR;
+			const std::vector<float>& mEnergy;
+#pragma endregion
+		};
+	}
+}
+
+#endif
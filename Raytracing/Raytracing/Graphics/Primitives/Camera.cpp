@@ -38,6 +38,28 @@ namespace Graphics {
 			return true;
 		}
 
+		// ------------------------------------------------------------------------
+		/*! Project
+		*
+		*   Finds the screen coordinates GenerateRay would need to reach a world
+		*	point. Fails if the point is not in front of the Camera
+		*/ // ---------------------------------------------------------------------
+		bool Camera::Project(const glm::dvec3& point, glm::dvec2& screen) const noexcept {
+			const glm::dvec3 direction = point - mCameraPosition;
+			const double depth = glm::dot(direction, mAlignmentVector);
+
+			//If the point is behind the camera, no ray goes through it
+			if (depth <= 0.0) return false;
+
+			// Intersect the screen plane and express the hit in U and V units.
+			const glm::dvec3 offset = mCameraPosition + direction * (mCameraLength / depth) - mProjectionScreenCenter;
+
+			screen.x = glm::dot(offset, mProjectionScreenU) / glm::dot(mProjectionScreenU, mProjectionScreenU);
+			screen.y = glm::dot(offset, mProjectionScreenV) / glm::dot(mProjectionScreenV, mProjectionScreenV);
+
+			return true;
+		}
+
 		// ------------------------------------------------------------------------
 		/*! Update Camera Geometry
 		*
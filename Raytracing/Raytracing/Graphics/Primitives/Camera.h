@@ -38,6 +38,7 @@ namespace Graphics {
 			DONTDISCARD inline double GetHorizonSize() const noexcept;
 			DONTDISCARD inline double GetAspectRatio() const noexcept;
 			bool GenerateRay(const double x, const double y, Trace::Ray& cameraRay) const noexcept;
+			bool Project(const glm::dvec3& point, glm::dvec2& screen) const noexcept;
 
 		private:
 			void UpdateCameraGeometry() noexcept;
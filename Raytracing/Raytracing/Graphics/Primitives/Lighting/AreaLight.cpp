@@ -0,0 +1,167 @@
+//
+//	AreaLight.cpp
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 23/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#include "AreaLight.h"
+#include <algorithm>
+#include <cmath>
+#include <glm/gtc/constants.hpp>
+#include "../../Sampling/SampleContext.h"
+#include "../../../Composition/InstanceBVH.h"
+
+namespace Graphics {
+	namespace Primitives {
+		namespace Lighting {
+			namespace {
+				// ------------------------------------------------------------------------
+				/*! Power Heuristic
+				*
+				*   Weights a sample drawn with one strategy against another (beta = 2)
+				*/ // ---------------------------------------------------------------------
+				double PowerHeuristic(const double pdf, const double other) noexcept {
+					return (pdf * pdf) / ((pdf * pdf) + (other * other));
+				}
+
+				// ------------------------------------------------------------------------
+				/*! Sample Cosine Hemisphere
+				*
+				*   Returns a direction around the normal, distributed as cos(theta) / pi
+				*/ // ---------------------------------------------------------------------
+				glm::dvec3 SampleCosineHemisphere(const glm::dvec3& normal, const glm::dvec2& u) noexcept {
+					// Orthonormal basis around the normal (Duff et al.)
+					const double sign = std::copysign(1.0, normal.z);
+					const double a = -1.0 / (sign + normal.z);
+					const double b = normal.x * normal.y * a;
+					const glm::dvec3 tangent(1.0 + sign * normal.x * normal.x * a, sign * b, -sign * normal.x);
+					const glm::dvec3 bitangent(b, sign + normal.y * normal.y * a, -normal.y);
+					const double r = std::sqrt(u.x), phi = glm::two_pi<double>() * u.y;
+
+					return (tangent * (r * std::cos(phi))) + (bitangent * (r * std::sin(phi))) + (normal * std::sqrt(std::max(1.0 - u.x, 0.0)));
+				}
+			}
+
+			// ------------------------------------------------------------------------
+			/*! Constructor
+			*
+			*   Sets the default values for the AreaLight
+			*/ // ---------------------------------------------------------------------
+			AreaLight::AreaLight() noexcept {
+				mColor = glm::dvec3(1.0f, 1.0f, 1.0f);
+				mPosition = glm::dvec3(0.0f, 0.0f, 0.0f);
+				mIntensity = 1.0f;
+			}
+
+			// ------------------------------------------------------------------------
+			/*! Destructor
+			*
+			*   Destroys the area light
+			*/ // ---------------------------------------------------------------------
+			AreaLight::~AreaLight() noexcept {}
+
+			// ------------------------------------------------------------------------
+			/*! Compute Lighting
+			*
+			*   Estimates the cosine weighted share of the hemisphere the light covers
+			*	(over pi), scaled by its intensity. One direction is picked on the light
+			*	and another one from the diffuse lobe, and both are combined through
+			*	multiple importance sampling, so neither small nor large lights are noisy
+			*/ // ---------------------------------------------------------------------
+			bool AreaLight::ComputeLighting(const glm::dvec3& inpoint, const glm::dvec3& innormal,
+				const std::vector<std::shared_ptr<Composition::Object>>& objlist,
+				const std::shared_ptr<Composition::Object>& obj,
+				glm::dvec3& color, double& intensity) noexcept {
+				const glm::dvec3 normal = glm::normalize(innormal);
+				const glm::dvec2 lightSample = Sampling::SampleContext::Next2D();
+				const glm::dvec2 bsdfSample = Sampling::SampleContext::Next2D();
+				glm::dvec3 direction;
+				double distance, lightPdf, estimate = 0.0;
+
+				// Light sampling, weighted against the chance of the diffuse lobe picking the same direction
+				if (Sample(inpoint, lightSample, direction, distance, lightPdf)) {
+					const double cosine = glm::dot(normal, direction);
+
+					if (cosine > 0.0 && IsVisible(inpoint, direction, distance, objlist, obj))
+						estimate += (cosine / glm::pi<double>()) / lightPdf * PowerHeuristic(lightPdf, cosine / glm::pi<double>());
+				}
+
+				// BSDF sampling, the cosine and pdf cancel out and only the weight is left
+				direction = SampleCosineHemisphere(normal, bsdfSample);
+
+				if (Intersect(inpoint, direction, distance, lightPdf) && IsVisible(inpoint, direction, distance, objlist, obj))
+					estimate += PowerHeuristic(glm::dot(normal, direction) / glm::pi<double>(), lightPdf);
+
+				color = mColor;
+				intensity = mIntensity * estimate;
+				return estimate > 0.0;
+			}
+
+			// ------------------------------------------------------------------------
+			/*! Compute Reflection
+			*
+			*   Estimates the light a surface reflects from this one, through the same
+			*	two samples as Compute Lighting: one picked on the light and one picked
+			*	by the BSDF, each weighted against the pdf the other would give it
+			*/ // ---------------------------------------------------------------------
+			bool AreaLight::ComputeReflection(const glm::dvec3& inpoint, const glm::dvec3& innormal,
+				const std::vector<std::shared_ptr<Composition::Object>>& objlist,
+				const std::shared_ptr<Composition::Object>& obj,
+				const Reflectance& bsdf, glm::dvec3& radiance) noexcept {
+				const glm::dvec3 normal = glm::normalize(innormal);
+				const glm::dvec2 lightSample = Sampling::SampleContext::Next2D();
+				const glm::dvec2 bsdfSample = Sampling::SampleContext::Next2D();
+				glm::dvec3 direction, estimate(0.0);
+				double distance, lightPdf, bsdfPdf;
+
+				// Light sampling, weighted against the chance of the BSDF picking the same direction
+				if (Sample(inpoint, lightSample, direction, distance, lightPdf)) {
+					const double cosine = glm::dot(normal, direction);
+
+					if (cosine > 0.0 && IsVisible(inpoint, direction, distance, objlist, obj)) {
+						const glm::dvec3 f = bsdf.Evaluate(direction, bsdfPdf);
+						estimate += f * (cosine / lightPdf * PowerHeuristic(lightPdf, bsdfPdf));
+					}
+				}
+
+				// BSDF sampling, weighted against the chance of the light picking the same direction
+				if (bsdf.Sample(bsdfSample, direction) && Intersect(inpoint, direction, distance, lightPdf) &&
+					IsVisible(inpoint, direction, distance, objlist, obj)) {
+					const glm::dvec3 f = bsdf.Evaluate(direction, bsdfPdf);
+
+					if (bsdfPdf > 0.0) estimate += f * (glm::dot(normal, direction) / bsdfPdf * PowerHeuristic(bsdfPdf, lightPdf));
+				}
+
+				radiance = mColor * estimate * mIntensity;
+				return estimate != glm::dvec3(0.0);
+			}
+
+			// ------------------------------------------------------------------------
+			/*! Is Visible
+			*
+			*   Returns whether nothing but the current object lies between a point
+			*	and the light, found at the given distance along a direction
+			*/ // ---------------------------------------------------------------------
+			bool AreaLight::IsVisible(const glm::dvec3& point, const glm::dvec3& direction, const double distance,
+				const std::vector<std::shared_ptr<Composition::Object>>& objlist,
+				const std::shared_ptr<Composition::Object>& obj) noexcept {
+				const Trace::Ray lightRay(point, point + direction);
+				glm::dvec3 poi, poiNormal, poiColor;
+
+				//If the scene built its instance tree, only the instances along the ray are tested
+				if (const Composition::InstanceBVH* instances = Composition::InstanceBVH::GetActive())
+					return !instances->IsOccluded(lightRay, obj.get(), distance);
+
+				// Check for intersections with other objects in front of the light
+				for (auto& sceneObject : objlist)
+					if (sceneObject != obj && sceneObject->TestIntersection(lightRay, poi, poiNormal, poiColor) &&
+						glm::length(poi - point) < distance)
+						return false;
+
+				return true;
+			}
+		}
+	}
+}
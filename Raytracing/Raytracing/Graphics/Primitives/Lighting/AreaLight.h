@@ -0,0 +1,48 @@
+//
+//	AreaLight.h
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 23/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#ifndef _AREA_LIGHT__H_
+#define _AREA_LIGHT__H_
+
+#include "Light.h"
+
+namespace Graphics {
+	namespace Primitives {
+		namespace Lighting {
+			class AreaLight : public Light {
+#pragma region //Constructors & Destructors
+			public:
+				AreaLight() noexcept;
+				virtual ~AreaLight() noexcept override;
+#pragma endregion
+
+#pragma region //Methods
+				DONTDISCARD bool ComputeLighting(const glm::dvec3& inpoint, const glm::dvec3& innormal,
+					const std::vector<std::shared_ptr<Composition::Object>>& objlist,
+					const std::shared_ptr<Composition::Object>& obj,
+					glm::dvec3& color, double& intensity) noexcept override;
+				DONTDISCARD bool ComputeReflection(const glm::dvec3& inpoint, const glm::dvec3& innormal,
+					const std::vector<std::shared_ptr<Composition::Object>>& objlist,
+					const std::shared_ptr<Composition::Object>& obj,
+					const Reflectance& bsdf, glm::dvec3& radiance) noexcept override;
+			protected:
+				DONTDISCARD virtual bool Sample(const glm::dvec3& point, const glm::dvec2& u, glm::dvec3& direction,
+					double& distance, double& pdf) const noexcept = 0;
+				DONTDISCARD virtual bool Intersect(const glm::dvec3& point, const glm::dvec3& direction,
+					double& distance, double& pdf) const noexcept = 0;
+			private:
+				DONTDISCARD static bool IsVisible(const glm::dvec3& point, const glm::dvec3& direction, const double distance,
+					const std::vector<std::shared_ptr<Composition::Object>>& objlist,
+					const std::shared_ptr<Composition::Object>& obj) noexcept;
+#pragma endregion
+			};
+		}
+	}
+}
+
+#endif
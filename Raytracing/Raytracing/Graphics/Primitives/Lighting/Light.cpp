@@ -7,6 +7,7 @@
 //
 
 #include "Light.h"
+#include <glm/gtc/constants.hpp>
 
 namespace Graphics {
 	namespace Primitives {
@@ -25,6 +26,28 @@ namespace Graphics {
 			*   Destroys the Light
 			*/ // ---------------------------------------------------------------------
 			Light::~Light() {}
+
+			// ------------------------------------------------------------------------
+			/*! Compute Reflection
+			*
+			*   Computes the light a surface reflects from this one towards the viewer.
+			*	Lights without an area are only seen along the direction to their
+			*	position, so the BSDF is evaluated there
+			*/ // ---------------------------------------------------------------------
+			bool Light::ComputeReflection(const glm::dvec3& inpoint, const glm::dvec3& innormal,
+				const std::vector<std::shared_ptr<Composition::Object>>& objlist,
+				const std::shared_ptr<Composition::Object>& obj,
+				const Reflectance& bsdf, glm::dvec3& radiance) {
+				glm::dvec3 color;
+				double intensity, pdf;
+
+				//If the light doesn't reach the point, nothing is reflected
+				if (!ComputeLighting(inpoint, innormal, objlist, obj, color, intensity)) return false;
+
+				// Lights hand out irradiance over pi, hence the pi on the BSDF
+				radiance = color * bsdf.Evaluate(glm::normalize(mPosition - inpoint), pdf) * (glm::pi<double>() * intensity);
+				return true;
+			}
 		}
 	}
 }
\ No newline at end of file
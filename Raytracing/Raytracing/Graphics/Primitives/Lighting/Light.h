@@ -18,8 +18,19 @@ namespace Graphics {
 	namespace Primitives {
 		namespace Lighting {
 			class Light {
-#pragma region //Constructors & Destructors
+#pragma region //Declarations
 			public:
+				// How a surface reflects light, for lights to weigh their samples by it.
+				// Evaluate gives the BSDF towards a direction (cosine left out) and the pdf
+				// Sample would pick that direction with
+				struct Reflectance {
+					virtual ~Reflectance() noexcept = default;
+					DONTDISCARD virtual glm::dvec3 Evaluate(const glm::dvec3& direction, double& pdf) const noexcept = 0;
+					DONTDISCARD virtual bool Sample(const glm::dvec2& u, glm::dvec3& direction) const noexcept = 0;
+				};
+#pragma endregion
+
+#pragma region //Constructors & Destructors
 				Light();
 				virtual ~Light();
 #pragma endregion
@@ -29,6 +40,10 @@ namespace Graphics {
 					const std::vector<std::shared_ptr<Composition::Object>>& objlist,
 					const std::shared_ptr<Composition::Object>& obj,
 					glm::dvec3& color, double& intensity);
+				DONTDISCARD virtual bool ComputeReflection(const glm::dvec3& inpoint, const glm::dvec3& innormal,
+					const std::vector<std::shared_ptr<Composition::Object>>& objlist,
+					const std::shared_ptr<Composition::Object>& obj,
+					const Reflectance& bsdf, glm::dvec3& radiance);
 				void inline SetColor(const glm::dvec3& color);
 				void inline SetPosition(const glm::dvec3& position);
 				DONTDISCARD inline glm::dvec3 GetPosition() const noexcept;
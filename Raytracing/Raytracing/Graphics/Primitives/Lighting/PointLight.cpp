@@ -7,6 +7,7 @@
 //
 
 #include "PointLight.h"
+#include "../../../Composition/InstanceBVH.h"
 
 namespace Graphics {
 	namespace Primitives {
@@ -49,7 +50,9 @@ namespace Graphics {
 				bool validInt = false;
 
 				// Check for intersections with other objects.
-				for (auto& sceneObject : objlist) {
+				if (const Composition::InstanceBVH* instances = Composition::InstanceBVH::GetActive())
+					validInt = instances->IsOccluded(lightRay, obj.get(), std::numeric_limits<double>::max());
+				else for (auto& sceneObject : objlist) {
 					// If the object is not the current object.
 					if (sceneObject != obj)
 						validInt = sceneObject->TestIntersection(lightRay, poi, poiNormal, poiColor);
@@ -0,0 +1,97 @@
+//
+//	RectangleLight.cpp
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 23/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#include "RectangleLight.h"
+#include <cmath>
+
+namespace Graphics {
+	namespace Primitives {
+		namespace Lighting {
+			// ------------------------------------------------------------------------
+			/*! Constructor
+			*
+			*   Sets the default values for the RectangleLight, a unit square facing -Z
+			*/ // ---------------------------------------------------------------------
+			RectangleLight::RectangleLight() noexcept {
+				SetEdges(glm::dvec3(0.0, 1.0, 0.0), glm::dvec3(1.0, 0.0, 0.0));
+			}
+
+			// ------------------------------------------------------------------------
+			/*! Destructor
+			*
+			*   Destroys the rectangle light
+			*/ // ---------------------------------------------------------------------
+			RectangleLight::~RectangleLight() noexcept {}
+
+			// ------------------------------------------------------------------------
+			/*! Set Edges
+			*
+			*   Sets the two (perpendicular) sides of the rectangle, centered at the
+			*	light's position. Light only leaves through the side cross(u, v) faces
+			*/ // ---------------------------------------------------------------------
+			void RectangleLight::SetEdges(const glm::dvec3& u, const glm::dvec3& v) noexcept {
+				const glm::dvec3 normal = glm::cross(u, v);
+
+				mEdgeU = u;
+				mEdgeV = v;
+				mArea = glm::length(normal);
+				mNormal = normal / mArea;
+			}
+
+			// ------------------------------------------------------------------------
+			/*! Sample
+			*
+			*   Picks a point uniformly over the rectangle, turning its area pdf into
+			*	a solid angle one as seen from the given point
+			*/ // ---------------------------------------------------------------------
+			bool RectangleLight::Sample(const glm::dvec3& point, const glm::dvec2& u, glm::dvec3& direction,
+				double& distance, double& pdf) const noexcept {
+				const glm::dvec3 toLight = mPosition + (mEdgeU * (u.x - 0.5)) + (mEdgeV * (u.y - 0.5)) - point;
+
+				distance = glm::length(toLight);
+				direction = toLight / distance;
+
+				const double cosine = -glm::dot(mNormal, direction);
+
+				//If the point is behind the light, it can't see it
+				if (cosine <= 0.0) return false;
+
+				pdf = (distance * distance) / (mArea * cosine);
+				return true;
+			}
+
+			// ------------------------------------------------------------------------
+			/*! Intersect
+			*
+			*   Finds whether a ray from the point reaches the lit side of the rectangle
+			*/ // ---------------------------------------------------------------------
+			bool RectangleLight::Intersect(const glm::dvec3& point, const glm::dvec3& direction,
+				double& distance, double& pdf) const noexcept {
+				const double cosine = -glm::dot(mNormal, direction);
+
+				//If the ray runs along or away from the lit side, it will never hit it
+				if (cosine <= 0.0) return false;
+
+				distance = glm::dot(point - mPosition, mNormal) / cosine;
+
+				//If the light is behind the ray, there is nothing to hit
+				if (distance <= 0.0) return false;
+
+				const glm::dvec3 local = point + (direction * distance) - mPosition;
+
+				//If the hit lies outside of the rectangle, the light was missed
+				if (std::abs(glm::dot(local, mEdgeU)) > 0.5 * glm::dot(mEdgeU, mEdgeU) ||
+					std::abs(glm::dot(local, mEdgeV)) > 0.5 * glm::dot(mEdgeV, mEdgeV))
+					return false;
+
+				pdf = (distance * distance) / (mArea * cosine);
+				return true;
+			}
+		}
+	}
+}
@@ -0,0 +1,44 @@
+//
+//	RectangleLight.h
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 23/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#ifndef _RECTANGLE_LIGHT__H_
+#define _RECTANGLE_LIGHT__H_
+
+#include "AreaLight.h"
+
+namespace Graphics {
+	namespace Primitives {
+		namespace Lighting {
+			class RectangleLight : public AreaLight {
+#pragma region //Constructors & Destructors
+			public:
+				RectangleLight() noexcept;
+				virtual ~RectangleLight() noexcept override;
+#pragma endregion
+
+#pragma region //Methods
+				void SetEdges(const glm::dvec3& u, const glm::dvec3& v) noexcept;
+			protected:
+				DONTDISCARD bool Sample(const glm::dvec3& point, const glm::dvec2& u, glm::dvec3& direction,
+					double& distance, double& pdf) const noexcept override;
+				DONTDISCARD bool Intersect(const glm::dvec3& point, const glm::dvec3& direction,
+					double& distance, double& pdf) const noexcept override;
+#pragma endregion
+
+#pragma region //Members
+			private:
+				glm::dvec3 mEdgeU, mEdgeV;
+				glm::dvec3 mNormal;
+				double mArea;
+#pragma endregion
+			};
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,108 @@
+//
+//	SphereLight.cpp
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 23/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#include "SphereLight.h"
+#include <algorithm>
+#include <cmath>
+#include <glm/gtc/constants.hpp>
+
+namespace Graphics {
+	namespace Primitives {
+		namespace Lighting {
+			// ------------------------------------------------------------------------
+			/*! Constructor
+			*
+			*   Sets the default values for the SphereLight
+			*/ // ---------------------------------------------------------------------
+			SphereLight::SphereLight() noexcept :
+				mRadius{ 0.5 } {}
+
+			// ------------------------------------------------------------------------
+			/*! Destructor
+			*
+			*   Destroys the sphere light
+			*/ // ---------------------------------------------------------------------
+			SphereLight::~SphereLight() noexcept {}
+
+			// ------------------------------------------------------------------------
+			/*! Sample
+			*
+			*   Picks a direction uniformly within the cone the sphere subtends from
+			*	the point, which never wastes samples on its hidden back side
+			*/ // ---------------------------------------------------------------------
+			bool SphereLight::Sample(const glm::dvec3& point, const glm::dvec2& u, glm::dvec3& direction,
+				double& distance, double& pdf) const noexcept {
+				double cosMax;
+
+				if (!GetCone(point, cosMax, pdf)) return false;
+
+				// Frame around the direction to the center
+				const glm::dvec3 axis = glm::normalize(mPosition - point);
+				const glm::dvec3 tangent = glm::normalize(glm::cross(std::abs(axis.x) > 0.9 ? glm::dvec3(0.0, 1.0, 0.0) :
+					glm::dvec3(1.0, 0.0, 0.0), axis));
+				const glm::dvec3 bitangent = glm::cross(axis, tangent);
+				const double oneMinusCos = u.x / (glm::two_pi<double>() * pdf);
+				const double cosTheta = 1.0 - oneMinusCos;
+				const double sinTheta = std::sqrt(std::max(oneMinusCos * (2.0 - oneMinusCos), 0.0));
+				const double phi = glm::two_pi<double>() * u.y;
+
+				direction = (tangent * (sinTheta * std::cos(phi))) + (bitangent * (sinTheta * std::sin(phi))) + (axis * cosTheta);
+
+				// Grazing directions may miss by rounding, in which case they just touch the silhouette
+				const glm::dvec3 toCenter = mPosition - point;
+				const double along = glm::dot(toCenter, direction);
+
+				distance = along - std::sqrt(std::max((mRadius * mRadius) - (glm::dot(toCenter, toCenter) - (along * along)), 0.0));
+				return true;
+			}
+
+			// ------------------------------------------------------------------------
+			/*! Intersect
+			*
+			*   Finds whether a ray from the point hits the sphere
+			*/ // ---------------------------------------------------------------------
+			bool SphereLight::Intersect(const glm::dvec3& point, const glm::dvec3& direction,
+				double& distance, double& pdf) const noexcept {
+				double cosMax;
+
+				if (!GetCone(point, cosMax, pdf)) return false;
+
+				const glm::dvec3 toCenter = mPosition - point;
+				const double along = glm::dot(toCenter, direction);
+				const double discriminant = (mRadius * mRadius) - (glm::dot(toCenter, toCenter) - (along * along));
+
+				//If the ray passes by the sphere or it is behind, it can't be hit
+				if (along <= 0.0 || discriminant < 0.0) return false;
+
+				distance = along - std::sqrt(discriminant);
+				return true;
+			}
+
+			// ------------------------------------------------------------------------
+			/*! Get Cone
+			*
+			*   Returns the cosine of the half angle the sphere subtends from a point,
+			*	and the pdf of picking any direction within it. Points inside the
+			*	sphere don't get lit
+			*/ // ---------------------------------------------------------------------
+			bool SphereLight::GetCone(const glm::dvec3& point, double& cosMax, double& pdf) const noexcept {
+				const glm::dvec3 toCenter = mPosition - point;
+				const double sin2Max = (mRadius * mRadius) / glm::dot(toCenter, toCenter);
+
+				//If the point is inside the light, there is no cone to sample
+				if (sin2Max >= 1.0) return false;
+
+				cosMax = std::sqrt(1.0 - sin2Max);
+
+				// 1 - cos(max), written so it doesn't cancel out on small, distant lights
+				pdf = 1.0 / (glm::two_pi<double>() * (sin2Max / (1.0 + cosMax)));
+				return true;
+			}
+		}
+	}
+}
@@ -0,0 +1,52 @@
+//
+//	SphereLight.h
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 23/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#ifndef _SPHERE_LIGHT__H_
+#define _SPHERE_LIGHT__H_
+
+#include "AreaLight.h"
+
+namespace Graphics {
+	namespace Primitives {
+		namespace Lighting {
+			class SphereLight : public AreaLight {
+#pragma region //Constructors & Destructors
+			public:
+				SphereLight() noexcept;
+				virtual ~SphereLight() noexcept override;
+#pragma endregion
+
+#pragma region //Methods
+				void inline SetRadius(const double radius) noexcept;
+			protected:
+				DONTDISCARD bool Sample(const glm::dvec3& point, const glm::dvec2& u, glm::dvec3& direction,
+					double& distance, double& pdf) const noexcept override;
+				DONTDISCARD bool Intersect(const glm::dvec3& point, const glm::dvec3& direction,
+					double& distance, double& pdf) const noexcept override;
+			private:
+				DONTDISCARD bool GetCone(const glm::dvec3& point, double& cosMax, double& pdf) const noexcept;
+#pragma endregion
+
+#pragma region //Members
+				double mRadius;
+#pragma endregion
+			};
+
+			// ------------------------------------------------------------------------
+			/*! Set Radius
+			*
+			*   Sets the Radius of the sphere, centered at the light's position
+			*/ // ---------------------------------------------------------------------
+			void SphereLight::SetRadius(const double radius) noexcept {
+				mRadius = radius;
+			}
+		}
+	}
+}
+
+#endif
@@ -7,6 +7,9 @@
 //
 
 #include "Material.h"
+#include <algorithm>
+#include "../Sampling/SampleContext.h"
+#include "../../Composition/InstanceBVH.h"
 
 namespace Graphics {
 	namespace Primitives {
@@ -24,6 +27,15 @@ namespace Graphics {
 		*/ // ---------------------------------------------------------------------
 		Material::~Material() noexcept {}
 
+		// ------------------------------------------------------------------------
+		/*! Get Color
+		*
+		*   Returns the base color of the Material
+		*/ // ---------------------------------------------------------------------
+		glm::dvec3 Material::GetColor() const noexcept {
+			return mColor;
+		}
+
 		// ------------------------------------------------------------------------
 		/*! Compute Color
 		*
@@ -85,19 +97,41 @@ namespace Graphics {
 		// ------------------------------------------------------------------------
 		/*! Compute Color Reflection
 		*
-		*   Computes the color reflection
+		*   Computes the color of the mirror reflection
 		*/ // ---------------------------------------------------------------------
 		glm::dvec3 Material::ComputeColorReflection(const std::vector<std::shared_ptr<Composition::Object>>& objList,
 																		const std::vector<std::shared_ptr<Lighting::Light>>& lightList, 
 																		const std::shared_ptr<Composition::Object>& currObject, 
 																		const glm::dvec3& intersectionPoint, const glm::dvec3& normalPoint,
 																		const Trace::Ray& camRay) const noexcept {
-			glm::dvec3 reflectionColor = glm::dvec3(0.f);
 			glm::dvec3 d = camRay.GetEndPoint() - camRay.GetOrigin();
 			glm::dvec3 reflectionVector = glm::reflect(d, normalPoint); //MIGHT POTENTIALLY BE WRONG
 
-			Trace::Ray reflectionRay(intersectionPoint, intersectionPoint + reflectionVector);
+			return ComputeColorAlong(objList, lightList, Trace::Ray(intersectionPoint, intersectionPoint + reflectionVector));
+		}
+
+		// ------------------------------------------------------------------------
+		/*! Compute Color Along
+		*
+		*   Computes the color coming back along a secondary ray. Past the roulette
+		*	depth, the path only goes on with a chance proportional to its
+		*	throughput, and the survivors are scaled up to make up for the rest
+		*/ // ---------------------------------------------------------------------
+		glm::dvec3 Material::ComputeColorAlong(const std::vector<std::shared_ptr<Composition::Object>>& objList,
+			const std::vector<std::shared_ptr<Lighting::Light>>& lightList, const Trace::Ray& reflectionRay) const noexcept {
+			const double contribution = std::max({ mThroughput.x, mThroughput.y, mThroughput.z });
+			double survival = 1.0;
+
+			//If the path is too deep or carries next to nothing, it isn't worth following
+			if (mReflectionRayCount >= mReflectionCountMax || contribution < mThroughputCutoff) return glm::dvec3(0.0);
+
+			//If the path loses the roulette, it ends here
+			if (mReflectionRayCount >= mRouletteDepth) {
+				survival = std::min(contribution, 1.0);
+				if (Sampling::SampleContext::Next2D().x >= survival) return glm::dvec3(0.0);
+			}
 
+			glm::dvec3 reflectionColor = glm::dvec3(0.f);
 			std::shared_ptr<Composition::Object> closestObject;
 			glm::dvec3 closestinpoint = glm::dvec3(0.f);
 			glm::dvec3 closestinnormal = glm::dvec3(0.f);
@@ -105,7 +139,10 @@ namespace Graphics {
 			bool intersection = CastRay(reflectionRay, objList, closestObject, closestinpoint, closestinnormal, closestoutcolor);
 
 			glm::dvec3 matColor = glm::dvec3();
-			if (intersection && mReflectionRayCount < mReflectionCountMax) {
+			if (intersection) {
+				const glm::dvec3 throughput = mThroughput;
+
+				mThroughput /= survival;
 				mReflectionRayCount++;
 				if (closestObject->HasMaterial()) {
 					matColor = closestObject->GetMaterial()->ComputeColor(objList, lightList, closestObject, closestinpoint, closestinnormal, reflectionRay);
@@ -113,6 +150,9 @@ namespace Graphics {
 				else {
 					matColor = ComputeColorDiffuse(objList, lightList, closestObject, closestinpoint, closestinnormal, closestObject->GetColor());
 				}
+
+				mThroughput = throughput;
+				matColor /= survival;
 			}
 			else {
 				reflectionColor = glm::dvec3(0.0f);
@@ -137,6 +177,10 @@ namespace Graphics {
 			double minDist = std::numeric_limits<double>::max();
 			bool foundIntersection = false;
 
+			//If the scene built its instance tree, only the instances along the ray are tested
+			if (const Composition::InstanceBVH* instances = Composition::InstanceBVH::GetActive())
+				return instances->CastRay(ray, closestobj, inpoint, innormal, outcolor);
+
 			for (auto& obj : objList) {
 				if (obj->TestIntersection(ray, intPoint, localNormal, localColor)) {
 					foundIntersection = true;
@@ -44,6 +44,11 @@ namespace Graphics {
 				const std::shared_ptr<Composition::Object>& currObject,
 				const glm::dvec3& intersectionPoint, const glm::dvec3& normalPoint,
 				const Trace::Ray& camRay) const noexcept;
+			DONTDISCARD glm::dvec3 ComputeColorAlong(
+				const std::vector<std::shared_ptr<Composition::Object>>& objList,
+				const std::vector<std::shared_ptr<Lighting::Light>>& lightList,
+				const Trace::Ray& reflectionRay) const noexcept;
+			DONTDISCARD virtual glm::dvec3 GetColor() const noexcept;
 			bool CastRay(const Trace::Ray& ray, 
 								const std::vector<std::shared_ptr<Composition::Object>>& objList,	
 								std::shared_ptr<Composition::Object>& closestobj, 
@@ -51,8 +56,11 @@ namespace Graphics {
 #pragma endregion
 
 #pragma region //Members
-			inline static int mReflectionRayCount;
-			inline static int mReflectionCountMax;
+			inline static thread_local int mReflectionRayCount;
+			inline static thread_local int mReflectionCountMax = 8;
+			inline static thread_local int mRouletteDepth = 1;
+			inline static thread_local double mThroughputCutoff;
+			inline static thread_local glm::dvec3 mThroughput{ 1.0 };
 		protected:
 			glm::dvec3 mColor;
 #pragma endregion
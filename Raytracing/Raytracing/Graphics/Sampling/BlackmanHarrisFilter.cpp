@@ -0,0 +1,41 @@
+//
+//	BlackmanHarrisFilter.cpp
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 22/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#include "BlackmanHarrisFilter.h"
+#include <cmath>
+
+namespace Graphics {
+	namespace Sampling {
+		// ------------------------------------------------------------------------
+		/*! Custom Constructor
+		*
+		*   Constructs a Blackman-Harris Filter
+		*/ // ---------------------------------------------------------------------
+		BlackmanHarrisFilter::BlackmanHarrisFilter(const double radius) noexcept :
+			Filter(radius) {}
+
+		// ------------------------------------------------------------------------
+		/*! Evaluate
+		*
+		*   Separable 4 term Blackman-Harris window, which keeps edges sharp
+		*	with far less ringing than a windowed sinc
+		*/ // ---------------------------------------------------------------------
+		double BlackmanHarrisFilter::Evaluate(const glm::dvec2& offset) const noexcept {
+			const auto window = [this](const double x) {
+				//If the sample is out of reach, it does not contribute
+				if (std::abs(x) >= mRadius) return 0.0;
+
+				const double t = 2.0 * PI * (x + mRadius) / (2.0 * mRadius);
+
+				return 0.35875 - 0.48829 * std::cos(t) + 0.14128 * std::cos(2.0 * t) - 0.01168 * std::cos(3.0 * t);
+			};
+
+			return window(offset.x) * window(offset.y);
+		}
+	}
+}
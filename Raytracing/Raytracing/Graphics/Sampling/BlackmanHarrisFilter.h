@@ -0,0 +1,29 @@
+//
+//	BlackmanHarrisFilter.h
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 22/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#ifndef _BLACKMAN_HARRIS_FILTER__H_
+#define _BLACKMAN_HARRIS_FILTER__H_
+
+#include "Filter.h"
+
+namespace Graphics {
+	namespace Sampling {
+		class BlackmanHarrisFilter : public Filter {
+#pragma region //Constructors & Destructors
+		public:
+			BlackmanHarrisFilter(const double radius = 1.5) noexcept;
+#pragma endregion
+
+#pragma region //Methods
+			DONTDISCARD double Evaluate(const glm::dvec2& offset) const noexcept override;
+#pragma endregion
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,147 @@
+//
+//	BlueNoiseSampler.cpp
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 21/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#include "BlueNoiseSampler.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace Graphics {
+	namespace Sampling {
+		namespace {
+			constexpr std::uint32_t cMaskPixels = BlueNoiseSampler::cMaskSize * BlueNoiseSampler::cMaskSize;
+
+			// Spread of the energy every point radiates, in pixels
+			constexpr double cSigma = 1.5;
+
+			// ------------------------------------------------------------------------
+			/*! Void And Cluster
+			*
+			*   Ranks every pixel of a tileable mask so that any threshold of it is a
+			*	blue noise point set (Ulichney, The void-and-cluster method). Points
+			*	repel each other through a wrapping gaussian energy, and new points
+			*	always go to the emptiest spot
+			*/ // ---------------------------------------------------------------------
+			std::vector<float> VoidAndCluster(const std::uint32_t seed) {
+				constexpr int size = static_cast<int>(BlueNoiseSampler::cMaskSize);
+				std::vector<double> kernel(cMaskPixels), energy(cMaskPixels, 0.0);
+				std::vector<bool> points(cMaskPixels, false);
+				std::vector<float> mask(cMaskPixels);
+				std::mt19937 generator(seed);
+
+				for (int y = 0; y < size; y++)
+					for (int x = 0; x < size; x++) {
+						const int dx = std::min(x, size - x), dy = std::min(y, size - y);
+
+						kernel[y * size + x] = std::exp(-(dx * dx + dy * dy) / (2.0 * cSigma * cSigma));
+					}
+
+				const auto splat = [&](const std::uint32_t pixel, const double sign) {
+					const int px = pixel % size, py = pixel / size;
+
+					for (int y = 0; y < size; y++)
+						for (int x = 0; x < size; x++)
+							energy[y * size + x] += sign * kernel[((y - py + size) % size) * size + (x - px + size) % size];
+				};
+				const auto find = [&](const bool point, const bool highest) {
+					std::uint32_t best = 0;
+
+					for (std::uint32_t i = 0, found = 0; i < cMaskPixels; i++)
+						if (points[i] == point && (!found++ || (highest ? energy[i] > energy[best] : energy[i] < energy[best])))
+							best = i;
+
+					return best;
+				};
+
+				// Start from a tenth of the pixels, moving the tightest cluster into the largest void until it settles
+				const std::uint32_t initial = cMaskPixels / 10;
+
+				for (std::uint32_t placed = 0; placed < initial;) {
+					const std::uint32_t pixel = generator() % cMaskPixels;
+
+					if (!points[pixel]) points[pixel] = true, splat(pixel, 1.0), placed++;
+				}
+
+				for (;;) {
+					const std::uint32_t cluster = find(true, true);
+
+					points[cluster] = false, splat(cluster, -1.0);
+
+					const std::uint32_t hole = find(false, false);
+
+					points[hole] = true, splat(hole, 1.0);
+					if (hole == cluster) break;
+				}
+
+				// Rank the initial points by removing the tightest clusters first
+				std::vector<bool> initialPoints = points;
+				std::vector<double> initialEnergy = energy;
+
+				for (std::uint32_t rank = initial; rank-- > 0;) {
+					const std::uint32_t cluster = find(true, true);
+
+					points[cluster] = false, splat(cluster, -1.0);
+					mask[cluster] = static_cast<float>(rank);
+				}
+
+				// Then fill the largest voids until no pixel is left
+				points.swap(initialPoints);
+				energy.swap(initialEnergy);
+
+				for (std::uint32_t rank = initial; rank < cMaskPixels; rank++) {
+					const std::uint32_t hole = find(false, false);
+
+					points[hole] = true, splat(hole, 1.0);
+					mask[hole] = static_cast<float>(rank);
+				}
+
+				for (float& value : mask) value = (value + 0.5f) / cMaskPixels;
+
+				return mask;
+			}
+		}
+
+		// ------------------------------------------------------------------------
+		/*! Custom Constructor
+		*
+		*   Constructs a Blue Noise Sampler. The masks are shared by every sampler
+		*	and built the first time one is constructed
+		*/ // ---------------------------------------------------------------------
+		BlueNoiseSampler::BlueNoiseSampler(const std::uint32_t seed) :
+			Sampler(seed), mMasks{ GetMasks() } {}
+
+		// ------------------------------------------------------------------------
+		/*! Get Masks
+		*
+		*   Returns the two blue noise masks, one per axis
+		*/ // ---------------------------------------------------------------------
+		const std::array<std::vector<float>, 2>& BlueNoiseSampler::GetMasks() {
+			static const std::array<std::vector<float>, 2> masks = { VoidAndCluster(1), VoidAndCluster(2) };
+
+			return masks;
+		}
+
+		// ------------------------------------------------------------------------
+		/*! Get 2D
+		*
+		*   Returns the R2 sequence point index, rotated by the blue noise value
+		*	of the pixel. Neighbouring pixels get very different offsets, so the
+		*	error of the image is pushed to high frequencies, which the eye (and
+		*	the denoiser) barely notice. Every dimension shifts the masks around
+		*/ // ---------------------------------------------------------------------
+		glm::dvec2 BlueNoiseSampler::Get2D(const std::uint32_t x, const std::uint32_t y, const std::uint32_t index,
+			const std::uint32_t dimension) const noexcept {
+			const std::uint32_t shift = Hash(0, 0, dimension);
+			const std::uint32_t pixel = ((y + (shift >> 16)) % cMaskSize) * cMaskSize + (x + (shift & 0xffff)) % cMaskSize;
+			const double u = mMasks[0][pixel] + index * 0.7548776662466927;
+			const double v = mMasks[1][pixel] + index * 0.5698402909980532;
+
+			return { u - std::floor(u), v - std::floor(v) };
+		}
+	}
+}
@@ -0,0 +1,43 @@
+//
+//	BlueNoiseSampler.h
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 21/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#ifndef _BLUE_NOISE_SAMPLER__H_
+#define _BLUE_NOISE_SAMPLER__H_
+
+#include <array>
+#include <vector>
+#include "Sampler.h"
+
+namespace Graphics {
+	namespace Sampling {
+		class BlueNoiseSampler : public Sampler {
+#pragma region //Declarations
+		public:
+			// Side of the tileable blue noise masks
+			static constexpr std::uint32_t cMaskSize = 64;
+#pragma endregion
+
+#pragma region //Constructors & Destructors
+			BlueNoiseSampler(const std::uint32_t seed = 0);
+#pragma endregion
+
+#pragma region //Methods
+			DONTDISCARD glm::dvec2 Get2D(const std::uint32_t x, const std::uint32_t y, const std::uint32_t index,
+				const std::uint32_t dimension) const noexcept override;
+		private:
+			DONTDISCARD static const std::array<std::vector<float>, 2>& GetMasks();
+#pragma endregion
+
+#pragma region //Members
+			const std::array<std::vector<float>, 2>& mMasks;
+#pragma endregion
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,31 @@
+//
+//	BoxFilter.cpp
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 22/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#include "BoxFilter.h"
+
+namespace Graphics {
+	namespace Sampling {
+		// ------------------------------------------------------------------------
+		/*! Custom Constructor
+		*
+		*   Constructs a Box Filter. A radius of half a pixel averages each pixel's own samples
+		*/ // ---------------------------------------------------------------------
+		BoxFilter::BoxFilter(const double radius) noexcept :
+			Filter(radius) {}
+
+		// ------------------------------------------------------------------------
+		/*! Evaluate
+		*
+		*   Weights every sample inside the square equally
+		*/ // ---------------------------------------------------------------------
+		double BoxFilter::Evaluate(const glm::dvec2& offset) const noexcept {
+			// Half open, so a sample right on the border of two pixels only counts once
+			return -mRadius < offset.x && offset.x <= mRadius && -mRadius < offset.y && offset.y <= mRadius ? 1.0 : 0.0;
+		}
+	}
+}
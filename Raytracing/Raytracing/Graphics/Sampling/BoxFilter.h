@@ -0,0 +1,29 @@
+//
+//	BoxFilter.h
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 22/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#ifndef _BOX_FILTER__H_
+#define _BOX_FILTER__H_
+
+#include "Filter.h"
+
+namespace Graphics {
+	namespace Sampling {
+		class BoxFilter : public Filter {
+#pragma region //Constructors & Destructors
+		public:
+			BoxFilter(const double radius = 0.5) noexcept;
+#pragma endregion
+
+#pragma region //Methods
+			DONTDISCARD double Evaluate(const glm::dvec2& offset) const noexcept override;
+#pragma endregion
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,28 @@
+//
+//	Filter.cpp
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 22/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#include "Filter.h"
+
+namespace Graphics {
+	namespace Sampling {
+		// ------------------------------------------------------------------------
+		/*! Custom Constructor
+		*
+		*   Constructs a Filter covering a square of the given radius
+		*/ // ---------------------------------------------------------------------
+		Filter::Filter(const double radius) noexcept :
+			mRadius{ radius } {}
+
+		// ------------------------------------------------------------------------
+		/*! Destructor
+		*
+		*   Destroys the Filter
+		*/ // ---------------------------------------------------------------------
+		Filter::~Filter() noexcept {}
+	}
+}
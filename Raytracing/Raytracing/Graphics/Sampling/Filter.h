@@ -0,0 +1,46 @@
+//
+//	Filter.h
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 22/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#ifndef _FILTER__H_
+#define _FILTER__H_
+
+#include <glm/glm.hpp>
+#include "../../CommonDefines.h"
+
+namespace Graphics {
+	namespace Sampling {
+		class Filter {
+#pragma region //Constructors & Destructors
+		public:
+			Filter(const double radius) noexcept;
+			virtual ~Filter() noexcept;
+#pragma endregion
+
+#pragma region //Methods
+			DONTDISCARD virtual double Evaluate(const glm::dvec2& offset) const noexcept = 0;
+			DONTDISCARD inline double GetRadius() const noexcept;
+#pragma endregion
+
+#pragma region //Members
+		protected:
+			double mRadius;
+#pragma endregion
+		};
+
+		// ------------------------------------------------------------------------
+		/*! Get Radius
+		*
+		*   Returns how far from a sample, in pixels, the filter still weights it
+		*/ // ---------------------------------------------------------------------
+		double Filter::GetRadius() const noexcept {
+			return mRadius;
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,40 @@
+//
+//	SampleContext.cpp
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 23/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#include "SampleContext.h"
+
+namespace Graphics {
+	namespace Sampling {
+		// ------------------------------------------------------------------------
+		/*! Begin
+		*
+		*   Starts a new camera sample on this thread. Dimension 0 belongs to the
+		*	pixel offset, so the first dimension handed out is 1
+		*/ // ---------------------------------------------------------------------
+		void SampleContext::Begin(const Sampler* sampler, const std::uint32_t x, const std::uint32_t y, const std::uint32_t index) noexcept {
+			mSampler = sampler;
+			mX = x;
+			mY = y;
+			mIndex = index;
+			mDimension = 1;
+		}
+
+		// ------------------------------------------------------------------------
+		/*! Next 2D
+		*
+		*   Returns the next pair of values in [0, 1) of the current sample. If
+		*	nothing set up a sample, the center of the domain is returned
+		*/ // ---------------------------------------------------------------------
+		glm::dvec2 SampleContext::Next2D() noexcept {
+			//If there is no sampler, there are no random numbers to give
+			if (!mSampler) return glm::dvec2(0.5);
+
+			return mSampler->Get2D(mX, mY, mIndex, mDimension++);
+		}
+	}
+}
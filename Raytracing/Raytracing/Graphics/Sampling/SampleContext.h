@@ -0,0 +1,34 @@
+//
+//	SampleContext.h
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 23/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#ifndef _SAMPLE_CONTEXT__H_
+#define _SAMPLE_CONTEXT__H_
+
+#include "Sampler.h"
+
+namespace Graphics {
+	namespace Sampling {
+		// Camera sample being traced on this thread. Anything past the camera ray
+		// (lights, materials) takes its random numbers from here, one dimension after the other
+		class SampleContext {
+#pragma region //Methods
+		public:
+			static void Begin(const Sampler* sampler, const std::uint32_t x, const std::uint32_t y, const std::uint32_t index) noexcept;
+			DONTDISCARD static glm::dvec2 Next2D() noexcept;
+#pragma endregion
+
+#pragma region //Members
+		private:
+			inline static thread_local const Sampler* mSampler;
+			inline static thread_local std::uint32_t mX, mY, mIndex, mDimension;
+#pragma endregion
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,28 @@
+//
+//	Sampler.cpp
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 21/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#include "Sampler.h"
+
+namespace Graphics {
+	namespace Sampling {
+		// ------------------------------------------------------------------------
+		/*! Custom Constructor
+		*
+		*   Constructs a Sampler. Different seeds give different, equally good patterns
+		*/ // ---------------------------------------------------------------------
+		Sampler::Sampler(const std::uint32_t seed) noexcept :
+			mSeed{ seed } {}
+
+		// ------------------------------------------------------------------------
+		/*! Destructor
+		*
+		*   Destroys the Sampler
+		*/ // ---------------------------------------------------------------------
+		Sampler::~Sampler() noexcept {}
+	}
+}
@@ -0,0 +1,86 @@
+//
+//	Sampler.h
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 21/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#ifndef _SAMPLER__H_
+#define _SAMPLER__H_
+
+#include <cstdint>
+#include <glm/glm.hpp>
+#include "../../CommonDefines.h"
+
+namespace Graphics {
+	namespace Sampling {
+		class Sampler {
+#pragma region //Constructors & Destructors
+		public:
+			Sampler(const std::uint32_t seed) noexcept;
+			virtual ~Sampler() noexcept;
+#pragma endregion
+
+#pragma region //Methods
+			DONTDISCARD virtual glm::dvec2 Get2D(const std::uint32_t x, const std::uint32_t y, const std::uint32_t index,
+				const std::uint32_t dimension) const noexcept = 0;
+			DONTDISCARD inline double Get1D(const std::uint32_t x, const std::uint32_t y, const std::uint32_t index,
+				const std::uint32_t dimension) const noexcept;
+		protected:
+			DONTDISCARD static inline std::uint32_t Hash(std::uint32_t value) noexcept;
+			DONTDISCARD inline std::uint32_t Hash(const std::uint32_t x, const std::uint32_t y, const std::uint32_t dimension) const noexcept;
+			DONTDISCARD static inline double ToUnit(const std::uint32_t value) noexcept;
+#pragma endregion
+
+#pragma region //Members
+			std::uint32_t mSeed;
+#pragma endregion
+		};
+
+		// ------------------------------------------------------------------------
+		/*! Get 1D
+		*
+		*   Returns a single value in [0, 1), the first half of a 2D dimension
+		*/ // ---------------------------------------------------------------------
+		double Sampler::Get1D(const std::uint32_t x, const std::uint32_t y, const std::uint32_t index,
+			const std::uint32_t dimension) const noexcept {
+			return Get2D(x, y, index, dimension).x;
+		}
+
+		// ------------------------------------------------------------------------
+		/*! Hash
+		*
+		*   Mixes the bits of a 32 bit value (lowbias32)
+		*/ // ---------------------------------------------------------------------
+		std::uint32_t Sampler::Hash(std::uint32_t value) noexcept {
+			value ^= value >> 16;
+			value *= 0x7feb352du;
+			value ^= value >> 15;
+			value *= 0x846ca68bu;
+			value ^= value >> 16;
+			return value;
+		}
+
+		// ------------------------------------------------------------------------
+		/*! Hash
+		*
+		*   Returns the seed of a pixel dimension, so every pixel and dimension
+		*	gets its own decorrelated sequence
+		*/ // ---------------------------------------------------------------------
+		std::uint32_t Sampler::Hash(const std::uint32_t x, const std::uint32_t y, const std::uint32_t dimension) const noexcept {
+			return Hash(Hash(Hash(Hash(mSeed) ^ x) ^ y) ^ dimension);
+		}
+
+		// ------------------------------------------------------------------------
+		/*! To Unit
+		*
+		*   Maps 32 bits to [0, 1)
+		*/ // ---------------------------------------------------------------------
+		double Sampler::ToUnit(const std::uint32_t value) noexcept {
+			return value * (1.0 / 4294967296.0);
+		}
+	}
+}
+
+#endif
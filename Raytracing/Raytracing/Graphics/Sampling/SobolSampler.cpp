@@ -0,0 +1,75 @@
+//
+//	SobolSampler.cpp
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 21/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#include "SobolSampler.h"
+
+namespace Graphics {
+	namespace Sampling {
+		namespace {
+			// ------------------------------------------------------------------------
+			/*! Reverse Bits
+			*
+			*   Mirrors the bits of a 32 bit value
+			*/ // ---------------------------------------------------------------------
+			std::uint32_t ReverseBits(std::uint32_t value) noexcept {
+				value = (value << 16) | (value >> 16);
+				value = ((value & 0x00ff00ffu) << 8) | ((value & 0xff00ff00u) >> 8);
+				value = ((value & 0x0f0f0f0fu) << 4) | ((value & 0xf0f0f0f0u) >> 4);
+				value = ((value & 0x33333333u) << 2) | ((value & 0xccccccccu) >> 2);
+				value = ((value & 0x55555555u) << 1) | ((value & 0xaaaaaaaau) >> 1);
+				return value;
+			}
+
+			// ------------------------------------------------------------------------
+			/*! Owen Scramble
+			*
+			*   Randomly flips every bit depending on all the bits above it, which
+			*	keeps the value inside the same dyadic intervals (Burley, Practical
+			*	Hash-based Owen Scrambling)
+			*/ // ---------------------------------------------------------------------
+			std::uint32_t OwenScramble(std::uint32_t value, const std::uint32_t seed) noexcept {
+				value = ReverseBits(value);
+				value += seed;
+				value ^= value * 0x6c50b47cu;
+				value ^= value * 0xb82f1e52u;
+				value ^= value * 0xc7afe638u;
+				value ^= value * 0x8d22f6e6u;
+				return ReverseBits(value);
+			}
+		}
+
+		// ------------------------------------------------------------------------
+		/*! Custom Constructor
+		*
+		*   Constructs a Sobol Sampler
+		*/ // ---------------------------------------------------------------------
+		SobolSampler::SobolSampler(const std::uint32_t seed) noexcept :
+			Sampler(seed) {}
+
+		// ------------------------------------------------------------------------
+		/*! Get 2D
+		*
+		*   Returns point index of the first two Sobol dimensions, shuffled and
+		*	Owen scrambled with a different seed for every pixel and dimension.
+		*	Any power of two prefix of the samples of a pixel is stratified
+		*/ // ---------------------------------------------------------------------
+		glm::dvec2 SobolSampler::Get2D(const std::uint32_t x, const std::uint32_t y, const std::uint32_t index,
+			const std::uint32_t dimension) const noexcept {
+			const std::uint32_t seed = Hash(x, y, dimension);
+			std::uint32_t shuffled = OwenScramble(index, seed);
+			std::uint32_t second = 0;
+
+			// The second dimension uses the direction numbers of the polynomial x + 1
+			for (std::uint32_t direction = 1u << 31; shuffled; shuffled >>= 1, direction ^= direction >> 1)
+				if (shuffled & 1) second ^= direction;
+
+			return { ToUnit(OwenScramble(ReverseBits(OwenScramble(index, seed)), Hash(seed ^ 0x9e3779b9u))),
+				ToUnit(OwenScramble(second, Hash(seed ^ 0x7f4a7c15u))) };
+		}
+	}
+}
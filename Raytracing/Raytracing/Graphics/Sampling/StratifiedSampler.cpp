@@ -0,0 +1,83 @@
+//
+//	StratifiedSampler.cpp
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 21/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#include "StratifiedSampler.h"
+#include <cmath>
+
+namespace Graphics {
+	namespace Sampling {
+		namespace {
+			// ------------------------------------------------------------------------
+			/*! Permute
+			*
+			*   Returns element i of a random permutation of [0, length), picked by
+			*	the seed (Kensler, Correlated Multi-Jittered Sampling)
+			*/ // ---------------------------------------------------------------------
+			std::uint32_t Permute(std::uint32_t i, const std::uint32_t length, const std::uint32_t seed) noexcept {
+				std::uint32_t w = length - 1;
+
+				w |= w >> 1;
+				w |= w >> 2;
+				w |= w >> 4;
+				w |= w >> 8;
+				w |= w >> 16;
+
+				// Walk the cycle of a permutation of the next power of two until we land inside the range
+				do {
+					i ^= seed; i *= 0xe170893d; i ^= seed >> 16; i ^= (i & w) >> 4; i ^= seed >> 8; i *= 0x0929eb3f; i ^= seed >> 23;
+					i ^= (i & w) >> 1; i *= 1 | seed >> 27; i *= 0x6935fa69; i ^= (i & w) >> 11; i *= 0x74dcb303;
+					i ^= (i & w) >> 2; i *= 0x9e501cc3; i ^= (i & w) >> 2; i *= 0xc860a3df; i &= w; i ^= i >> 5;
+				} while (i >= length);
+
+				return (i + seed) % length;
+			}
+
+			// ------------------------------------------------------------------------
+			/*! Random Unit
+			*
+			*   Returns a random value in [0, 1) for a given index and seed
+			*/ // ---------------------------------------------------------------------
+			double RandomUnit(std::uint32_t i, const std::uint32_t seed) noexcept {
+				i ^= seed; i ^= i >> 17; i ^= i >> 10; i *= 0xb36534e5; i ^= i >> 12; i ^= i >> 21;
+				i *= 0x93fc4795; i ^= 0xdf6e307f; i ^= i >> 17; i *= 1 | seed >> 18;
+				return i * (1.0 / 4294967296.0);
+			}
+		}
+
+		// ------------------------------------------------------------------------
+		/*! Custom Constructor
+		*
+		*   Splits the pixel into the grid of strata closest to a square that
+		*	holds every sample
+		*/ // ---------------------------------------------------------------------
+		StratifiedSampler::StratifiedSampler(const std::uint32_t samplesPerPixel, const std::uint32_t seed) noexcept :
+			Sampler(seed), mColumns{ std::max(static_cast<std::uint32_t>(std::ceil(std::sqrt(static_cast<double>(samplesPerPixel)))), 1u) },
+			mRows{ (std::max(samplesPerPixel, 1u) + mColumns - 1) / mColumns } {}
+
+		// ------------------------------------------------------------------------
+		/*! Get 2D
+		*
+		*   Returns a correlated multi-jittered sample: samples fall into distinct
+		*	cells of the columns x rows grid, and into distinct rows and columns
+		*	of the fine grid, so both 2D and 1D projections are stratified. Once
+		*	every cell is used, a new pattern starts
+		*/ // ---------------------------------------------------------------------
+		glm::dvec2 StratifiedSampler::Get2D(const std::uint32_t x, const std::uint32_t y, const std::uint32_t index,
+			const std::uint32_t dimension) const noexcept {
+			const std::uint32_t cells = mColumns * mRows;
+			const std::uint32_t pattern = Hash(Hash(x, y, dimension) ^ (index / cells));
+			const std::uint32_t s = Permute(index % cells, cells, pattern * 0x51633e2d);
+			const std::uint32_t sx = Permute(s % mColumns, mColumns, pattern * 0x68bc21eb);
+			const std::uint32_t sy = Permute(s / mColumns, mRows, pattern * 0x02e5be93);
+			const double jx = RandomUnit(s, pattern * 0x967a889b);
+			const double jy = RandomUnit(s, pattern * 0x368cc8b7);
+
+			return { (sx + (sy + jx) / mRows) / mColumns, (s / mColumns + (sx + jy) / mColumns) / mRows };
+		}
+	}
+}
@@ -0,0 +1,35 @@
+//
+//	StratifiedSampler.h
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 21/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#ifndef _STRATIFIED_SAMPLER__H_
+#define _STRATIFIED_SAMPLER__H_
+
+#include "Sampler.h"
+
+namespace Graphics {
+	namespace Sampling {
+		class StratifiedSampler : public Sampler {
+#pragma region //Constructors & Destructors
+		public:
+			StratifiedSampler(const std::uint32_t samplesPerPixel, const std::uint32_t seed = 0) noexcept;
+#pragma endregion
+
+#pragma region //Methods
+			DONTDISCARD glm::dvec2 Get2D(const std::uint32_t x, const std::uint32_t y, const std::uint32_t index,
+				const std::uint32_t dimension) const noexcept override;
+#pragma endregion
+
+#pragma region //Members
+		private:
+			std::uint32_t mColumns, mRows;
+#pragma endregion
+		};
+	}
+}
+
+#endif
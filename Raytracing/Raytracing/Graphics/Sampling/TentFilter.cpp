@@ -0,0 +1,32 @@
+//
+//	TentFilter.cpp
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 22/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#include "TentFilter.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Graphics {
+	namespace Sampling {
+		// ------------------------------------------------------------------------
+		/*! Custom Constructor
+		*
+		*   Constructs a Tent Filter
+		*/ // ---------------------------------------------------------------------
+		TentFilter::TentFilter(const double radius) noexcept :
+			Filter(radius) {}
+
+		// ------------------------------------------------------------------------
+		/*! Evaluate
+		*
+		*   Weights samples linearly less the further they are, on each axis
+		*/ // ---------------------------------------------------------------------
+		double TentFilter::Evaluate(const glm::dvec2& offset) const noexcept {
+			return std::max(mRadius - std::abs(offset.x), 0.0) * std::max(mRadius - std::abs(offset.y), 0.0);
+		}
+	}
+}
@@ -0,0 +1,29 @@
+//
+//	TentFilter.h
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 22/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#ifndef _TENT_FILTER__H_
+#define _TENT_FILTER__H_
+
+#include "Filter.h"
+
+namespace Graphics {
+	namespace Sampling {
+		class TentFilter : public Filter {
+#pragma region //Constructors & Destructors
+		public:
+			TentFilter(const double radius = 1.0) noexcept;
+#pragma endregion
+
+#pragma region //Methods
+			DONTDISCARD double Evaluate(const glm::dvec2& offset) const noexcept override;
+#pragma endregion
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,175 @@
+//
+//	Box.cpp
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 29/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#include "Box.h"
+#include <cfloat>
+
+namespace Graphics {
+	namespace Shapes {
+		namespace {
+			// Below this, a transformed axis is taken to have no component along a
+			// world one (a rotation by a single precision PI / 2 leaves ~4e-8 behind)
+			constexpr double cAlignmentTolerance = 1e-7;
+
+			// ------------------------------------------------------------------------
+			/*! Intersect Slabs
+			*
+			*   Slab test of a ray against a box. Gives back the distance to the face
+			*	the ray enters through (or leaves through, if it starts inside) and the
+			*	outward normal of that face
+			*/ // ---------------------------------------------------------------------
+			bool IntersectSlabs(const glm::dvec3& origin, const glm::dvec3& direction, const glm::dvec3& min,
+				const glm::dvec3& max, double& t, glm::dvec3& normal) noexcept {
+				double tEnter = -DBL_MAX, tExit = DBL_MAX;
+				int enterAxis = 0, exitAxis = 0;
+
+				for (int i = 0; i < 3; i++) {
+					// Axes the ray runs parallel to get a huge inverse, so origins right on
+					//	a slab don't turn into NaNs
+					const double inverse = direction[i] != 0.0 ? 1.0 / direction[i] : std::copysign(DBL_MAX, direction[i]);
+					const double t1 = (min[i] - origin[i]) * inverse, t2 = (max[i] - origin[i]) * inverse;
+					const double tNear = std::min(t1, t2), tFar = std::max(t1, t2);
+
+					if (tNear > tEnter) {
+						tEnter = tNear;
+						enterAxis = i;
+					}
+
+					if (tFar < tExit) {
+						tExit = tFar;
+						exitAxis = i;
+					}
+				}
+
+				//If the slabs don't overlap along the ray, or only behind it, it misses the box
+				if (tEnter > tExit || tExit <= 0.0) return false;
+
+				normal = glm::dvec3(0.0);
+
+				//If the ray starts outside, it hits the face it enters through
+				if (tEnter > 0.0) {
+					t = tEnter;
+					normal[enterAxis] = direction[enterAxis] > 0.0 ? -1.0 : 1.0;
+				} else {
+					t = tExit;
+					normal[exitAxis] = direction[exitAxis] > 0.0 ? 1.0 : -1.0;
+				}
+
+				return true;
+			}
+		}
+
+		// ------------------------------------------------------------------------
+		/*! Default Constructor
+		*
+		*   Constructs the box from -1 to 1 along every axis, to be placed with
+		*	a transform
+		*/ // ---------------------------------------------------------------------
+		Box::Box() noexcept {
+			Prepare();
+		}
+
+		// ------------------------------------------------------------------------
+		/*! Custom Constructor
+		*
+		*   Constructs an axis aligned box between two world space corners
+		*/ // ---------------------------------------------------------------------
+		Box::Box(const glm::dvec3& min, const glm::dvec3& max) noexcept {
+			SetTransform(Math::Transform{ (min + max) * 0.5, glm::dvec3(0.0), (max - min) * 0.5 });
+		}
+
+		// ------------------------------------------------------------------------
+		/*! Destructor
+		*
+		*  
+		*/ // ---------------------------------------------------------------------
+		Box::~Box() noexcept {}
+
+		// ------------------------------------------------------------------------
+		/*! Set Transform
+		*
+		*   Sets the transform, and works out whether the box stays axis aligned
+		*	under it
+		*/ // ---------------------------------------------------------------------
+		void Box::SetTransform(const Math::Transform& transform) noexcept {
+			Object::SetTransform(transform);
+			Prepare();
+		}
+
+		// ------------------------------------------------------------------------
+		/*! Test Intersection
+		*
+		*   Tests whether a ray intersects with the box. Axis aligned boxes are
+		*	tested right in world space, the rest through the inverse transform
+		*/ // ---------------------------------------------------------------------
+		bool Box::TestIntersection(const Trace::Ray& ray, glm::dvec3& inpoint, glm::dvec3& innormal, glm::dvec3& outcolor) noexcept {
+			double t;
+			glm::dvec3 normal;
+
+			if (mAxisAligned) {
+				const glm::dvec3 direction = ray.GetEndPoint() - ray.GetOrigin();
+
+				if (!IntersectSlabs(ray.GetOrigin(), direction, mMin, mMax, t, normal)) return false;
+
+				inpoint = ray.GetOrigin() + direction * t;
+				innormal = normal;
+			} else {
+				const Trace::Ray backray = mTransform.InverseTransformRay(ray);
+				const glm::dvec3 direction = backray.GetEndPoint() - backray.GetOrigin();
+
+				if (!IntersectSlabs(backray.GetOrigin(), direction, glm::dvec3(-1.0), glm::dvec3(1.0), t, normal)) return false;
+
+				inpoint = mTransform.ApplyTransform(backray.GetOrigin() + direction * t);
+				innormal = glm::normalize(mTransform.ApplyTransform(normal) - mTransform.ApplyTransform(glm::dvec3(0.0)));
+			}
+
+			outcolor = mColor;
+			return true;
+		}
+
+		// ------------------------------------------------------------------------
+		/*! Get Local Bounds
+		*
+		*   Returns the box itself, before the transform
+		*/ // ---------------------------------------------------------------------
+		Trace::AABB Box::GetLocalBounds() const noexcept {
+			return Trace::AABB{ glm::vec3(-1.f), glm::vec3(1.f) };
+		}
+
+		// ------------------------------------------------------------------------
+		/*! Prepare
+		*
+		*   Precomputes the world space corners of the box, if every one of its
+		*	axes ends up along a world one (only scaled, moved and turned in right
+		*	angles)
+		*/ // ---------------------------------------------------------------------
+		void Box::Prepare() noexcept {
+			const glm::dmat4 forward = mTransform.GetForward();
+			glm::dvec3 extent(0.0);
+
+			mAxisAligned = true;
+
+			for (int i = 0; i < 3; i++) {
+				const glm::dvec3 axis(forward[i]);
+				const double tolerance = cAlignmentTolerance * glm::length(axis);
+				int components = 0;
+
+				for (int j = 0; j < 3; j++)
+					if (std::abs(axis[j]) > tolerance) {
+						extent[j] += std::abs(axis[j]);
+						components++;
+					}
+
+				mAxisAligned &= components == 1;
+			}
+
+			mMin = glm::dvec3(forward[3]) - extent;
+			mMax = glm::dvec3(forward[3]) + extent;
+		}
+	}
+}
@@ -0,0 +1,41 @@
+//
+//	Box.h
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 29/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#ifndef _BOX__H_
+#define _BOX__H_
+
+#include <glm/glm.hpp>
+#include "../../Composition/Object.h"
+
+namespace Graphics {
+	namespace Shapes {
+		class Box : public Composition::Object {
+#pragma region //Constructors & Destructors
+		public:
+			Box() noexcept;
+			Box(const glm::dvec3& min, const glm::dvec3& max) noexcept;
+			virtual ~Box() noexcept;
+#pragma endregion
+
+#pragma region //Methods
+			void SetTransform(const Math::Transform& transform) noexcept override;
+			bool TestIntersection(const Trace::Ray& ray, glm::dvec3& inpoint, glm::dvec3& innormal, glm::dvec3& outcolor) noexcept override;
+			DONTDISCARD Trace::AABB GetLocalBounds() const noexcept override;
+		private:
+			void Prepare() noexcept;
+#pragma endregion
+
+#pragma region //Members
+			glm::dvec3 mMin, mMax;
+			bool mAxisAligned;
+#pragma endregion
+		};
+	}
+}
+
+#endif
@@ -1,5 +1,4 @@
 #include "Cylinder.h"
-#include <array>
 
 namespace Graphics {
 	namespace Shapes {
@@ -27,176 +26,82 @@ namespace Graphics {
 			// Get the start point of the line.
 			glm::dvec3 p = bckRay.GetOrigin();
 
-			// Compute a, b and c.
-			double a = std::pow(v.x, 2.0) + std::pow(v.y, 2.0);
-			double b = 2.0 * (p.x * v.x + p.y * v.y);
-			double c = std::pow(p.x, 2.0) + std::pow(p.y, 2.0) - 1.0;
-
-			// Compute b^2 - 4ac.
-			double numSQRT = sqrt(std::pow(b, 2.0) - 4 * a * c);
-
-			// Test for intersections.
-			// First with the cylinder itself.
-			std::array<glm::dvec3, 4> poi = {glm::dvec3(0), glm::dvec3(0), glm::dvec3(0), glm::dvec3(0)};
-			std::array<double, 4> t = {0, 0, 0, 0};
-			bool t1Valid = false;
-			bool t2Valid = false;
-			bool t3Valid = false;
-			bool t4Valid = false;
-			if (numSQRT > 0.0)
-			{
-				// There was an intersection.
-				// Compute the values for t.
-				t.at(0) = (-b + numSQRT) / (2 * a);
-				t.at(1) = (-b - numSQRT) / (2 * a);
+			// Rays missing the box around the cylinder can't hit it, so stop early.
+			if (!HitsLocalBounds(Cylinder::GetLocalBounds(), p, v))
+				return false;
 
-				// Compute the points of intersection.
-				poi.at(0) = bckRay.GetOrigin() + (v * t[0]);
-				poi.at(1) = bckRay.GetOrigin() + (v * t[1]);
+			// Keep track of the closest valid hit, and whether it was on a cap.
+			double minT = 100e6;
+			bool capHit = false;
 
-				// Check if any of these are valid.
-				if ((t.at(0) > 0.0) && (fabs(poi.at(0).z) < 1.0))
-				{
-					t1Valid = true;
-				}
-				else
-				{
-					t1Valid = false;
-					t.at(0) = 100e6;
-				}
+			// Compute a, b and c.
+			double a = v.x * v.x + v.y * v.y;
+			double b = 2.0 * (p.x * v.x + p.y * v.y);
+			double c = p.x * p.x + p.y * p.y - 1.0;
 
-				if ((t.at(1) > 0.0) && (fabs(poi.at(1).z) < 1.0))
-				{
-					t2Valid = true;
-				}
-				else
-				{
-					t2Valid = false;
-					t.at(1) = 100e6;
-				}
-			}
-			else
+			// Compute b^2 - 4ac, and test the cylinder itself if there are roots.
+			double disc = b * b - 4 * a * c;
+			if (disc > 0.0)
 			{
-				t1Valid = false;
-				t2Valid = false;
-				t.at(0) = 100e6;
-				t.at(1) = 100e6;
+				double numSQRT = sqrt(disc);
+
+				// As a is never negative, t2 is the nearest root and t1 only matters if it misses.
+				double t1 = (-b + numSQRT) / (2 * a);
+				double t2 = (-b - numSQRT) / (2 * a);
+				double z1 = p.z + v.z * t1;
+				double z2 = p.z + v.z * t2;
+
+				if ((t2 > 0.0) && (fabs(z2) < 1.0))
+					minT = t2;
+				if ((t1 > 0.0) && (t1 < minT) && (fabs(z1) < 1.0))
+					minT = t1;
 			}
 
 			// And test the end caps.
-			if (CloseEnough(v.z, 0.0))
+			if (!CloseEnough(v.z, 0.0))
 			{
-				t3Valid = false;
-				t4Valid = false;
-				t.at(2) = 100e6;
-				t.at(3) = 100e6;
-			}
-			else
-			{
-				// Compute the values of t.
-				t.at(2) = (bckRay.GetOrigin().z - 1.0) / -v.z;
-				t.at(3) = (bckRay.GetOrigin().z + 1.0) / -v.z;
-
-				// Compute the points of intersection.
-				poi.at(2) = bckRay.GetOrigin() + t.at(2) * v;
-				poi.at(3) = bckRay.GetOrigin() + t.at(3) * v;
-
-				// Check if these are valid.
-				if ((t.at(2) > 0.0) && (sqrt(std::pow(poi.at(2).x, 2.0) + std::pow(poi.at(2).y, 2.0)) < 1.0))
-				{
-					t3Valid = true;
-				}
-				else
-				{
-					t3Valid = false;
-					t.at(2) = 100e6;
-				}
+				double caps[2] = { (p.z - 1.0) / -v.z, (p.z + 1.0) / -v.z };
 
-				if ((t.at(3) > 0.0) && (sqrt(std::pow(poi.at(3).x, 2.0) + std::pow(poi.at(3).y, 2.0)) < 1.0))
+				for (double t : caps)
 				{
-					t4Valid = true;
-				}
-				else
-				{
-					t4Valid = false;
-					t.at(3) = 100e6;
+					// Only caps in front of the ray and closer than the hit so far matter.
+					if ((t > 0.0) && (t < minT))
+					{
+						double x = p.x + v.x * t;
+						double y = p.y + v.y * t;
+
+						if (x * x + y * y < 1.0)
+						{
+							minT = t;
+							capHit = true;
+						}
+					}
 				}
 			}
 
-			// If no valid intersections found, the we can stop.
-			if ((!t1Valid) && (!t2Valid) && (!t3Valid) && (!t4Valid))
+			// If no valid intersections found, then we can stop.
+			if (minT >= 100e6)
 				return false;
 
-			// Check for the smallest valid value of t.
-			int minIndex = 0;
-			double minValue = 10e6;
-			for (int i = 0; i < 4; ++i)
-			{
-				if (t.at(i) < minValue)
-				{
-					minValue = t.at(i);
-					minIndex = i;
-				}
-			}
+			// Compute the point of intersection, and transform it back into world coordinates.
+			glm::dvec3 validPOI = p + v * minT;
+			intPoint = mTransform.ApplyTransform(validPOI);
 
-			/* If minIndex is either 0 or 1, then we have a valid intersection
-				with the cylinder itself. */
-			glm::dvec3 validPOI = poi.at(minIndex);
-			if (minIndex < 2)
-			{
-				// Transform the intersection point back into world coordinates.
-				intPoint = mTransform.ApplyTransform(validPOI);
-
-				// Compute the local normal.
-				glm::dvec3 orgNormal = glm::dvec3(0);
-				glm::dvec3 newNormal = glm::dvec3(0);
-				glm::dvec3 localOrigin = glm::dvec3(0);
-				glm::dvec3 globalOrigin = mTransform.ApplyTransform(localOrigin);
-				orgNormal.x = validPOI.x;
-				orgNormal.y = validPOI.y;
-				orgNormal.z = 0.f;
-				newNormal = glm::normalize(mTransform.ApplyTransform(orgNormal) - globalOrigin);
-				localNormal = newNormal;
-
-				// Return the base color.
-				localColor = mColor;
-
-				return true;
-			}
-			else
-			{
-				// Otherwise check the end caps.
-				if (!CloseEnough(v.z, 0.0))
-				{
-					// Check if we are inside the disk.
-					if (sqrt(std::pow(validPOI.x, 2.0) + std::pow(validPOI.y, 2.0)) < 1.0)
-					{
-						// Transform the intersection point back into world coordinates.
-						intPoint = mTransform.ApplyTransform(validPOI);
-
-						// Compute the local normal.
-						glm::dvec3 localOrigin{0.0, 0.0, 0.0};
-						glm::dvec3 normalVector{ 0.0, 0.0, 0.0 + validPOI.z };
-						glm::dvec3 globalOrigin = mTransform.ApplyTransform(localOrigin);
-						localNormal = glm::normalize(mTransform.ApplyTransform(normalVector) - globalOrigin);
+			// Compute the local normal, from the side or the cap we hit.
+			glm::dvec3 orgNormal = capHit ? glm::dvec3(0.0, 0.0, validPOI.z) : glm::dvec3(validPOI.x, validPOI.y, 0.0);
+			glm::dvec3 globalOrigin = mTransform.ApplyTransform(glm::dvec3(0.0));
+			localNormal = glm::normalize(mTransform.ApplyTransform(orgNormal) - globalOrigin);
 
-						// Return the base color.
-						localColor = mColor;
+			// Return the base color.
+			localColor = mColor;
 
-						return true;
-					}
-					else
-					{
-						return false;
-					}
-				}
-				else
-				{
-					return false;
-				}
-			}
+			return true;
+		}
 
-			return false;
+		// The function returning the bounds before the transform.
+		Trace::AABB Cylinder::GetLocalBounds() const noexcept
+		{
+			return Trace::AABB{ glm::vec3(-1.f), glm::vec3(1.f) };
 		}
 	}
 }
\ No newline at end of file
@@ -15,6 +15,9 @@ namespace Graphics {
 			// Override the function to test for intersections.
 			virtual bool TestIntersection(const Trace::Ray& castRay, glm::dvec3& intPoint,
 				glm::dvec3& localNormal, glm::dvec3& localColor) noexcept override;
+
+			// Override the function returning the bounds before the transform.
+			virtual Trace::AABB GetLocalBounds() const noexcept override;
 		};
 	}
 }
\ No newline at end of file
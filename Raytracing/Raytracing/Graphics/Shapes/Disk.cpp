@@ -0,0 +1,58 @@
+//
+//	Disk.cpp
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 29/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#include "Disk.h"
+
+namespace Graphics {
+	namespace Shapes {
+		// ------------------------------------------------------------------------
+		/*! Default Constructor
+		*
+		*   Constructs the unit disk on the XY plane, to be placed with a transform
+		*/ // ---------------------------------------------------------------------
+		Disk::Disk() noexcept {}
+
+		// ------------------------------------------------------------------------
+		/*! Custom Constructor
+		*
+		*   Constructs a disk in world space, facing along the given normal
+		*/ // ---------------------------------------------------------------------
+		Disk::Disk(const glm::dvec3& center, const glm::dvec3& normal, const double radius) noexcept {
+			const glm::dvec3 facing = glm::normalize(normal);
+
+			// Any edge perpendicular to the normal will do, crossing it with an axis it is far from
+			const glm::dvec3 edgeU = glm::normalize(glm::cross(facing, std::abs(facing.x) < 0.9 ? glm::dvec3(1.0, 0.0, 0.0) : glm::dvec3(0.0, 1.0, 0.0))) * radius;
+			const glm::dvec3 edgeV = glm::cross(edgeU, facing);
+
+			SetTransform(Math::Transform{ glm::dmat4(glm::dvec4(edgeU, 0.0), glm::dvec4(edgeV, 0.0), glm::dvec4(-facing, 0.0), glm::dvec4(center, 1.0)) });
+		}
+
+		// ------------------------------------------------------------------------
+		/*! Destructor
+		*
+		*  
+		*/ // ---------------------------------------------------------------------
+		Disk::~Disk() noexcept {}
+
+		// ------------------------------------------------------------------------
+		/*! Test Intersection
+		*
+		*   Tests whether a ray intersects with the disk
+		*/ // ---------------------------------------------------------------------
+		bool Disk::TestIntersection(const Trace::Ray& ray, glm::dvec3& inpoint, glm::dvec3& innormal, glm::dvec3& outcolor) noexcept {
+			double u, v;
+
+			//If the plane is hit outside of the rim, the disk isn't
+			if (!IntersectPlane(ray, inpoint, u, v) || u * u + v * v > 1.0) return false;
+
+			innormal = mNormal;
+			outcolor = mColor;
+			return true;
+		}
+	}
+}
@@ -0,0 +1,31 @@
+//
+//	Disk.h
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 29/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#ifndef _DISK__H_
+#define _DISK__H_
+
+#include "Quad.h"
+
+namespace Graphics {
+	namespace Shapes {
+		class Disk : public Quad {
+#pragma region //Constructors & Destructors
+		public:
+			Disk() noexcept;
+			Disk(const glm::dvec3& center, const glm::dvec3& normal, const double radius) noexcept;
+			virtual ~Disk() noexcept;
+#pragma endregion
+
+#pragma region //Methods
+			bool TestIntersection(const Trace::Ray& ray, glm::dvec3& inpoint, glm::dvec3& innormal, glm::dvec3& outcolor) noexcept override;
+#pragma endregion
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,325 @@
+//
+//	DistanceField.h
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 30/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#ifndef _DISTANCE_FIELD__H_
+#define _DISTANCE_FIELD__H_
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <type_traits>
+#include <glm/glm.hpp>
+#include "../../Trace/BVH.h"
+
+// Signed distance fields, built out of the primitives and operations below.
+// Every node is a small value type giving the distance to its surface at a
+// point (negative inside) and a box around it. Trees put together out of
+// them have their whole type known at compile time, so evaluating one is
+// inlined into a single function. Field erases that type, to keep trees in
+// objects or put them together at runtime, as a Field is a node too
+namespace Graphics {
+	namespace Shapes {
+		namespace SDF {
+			// Sphere around the origin
+			struct Sphere {
+				double radius;
+
+				explicit Sphere(const double radius) noexcept : radius(radius) {}
+
+				DONTDISCARD double operator()(const glm::dvec3& p) const noexcept {
+					return glm::length(p) - radius;
+				}
+
+				DONTDISCARD Trace::AABB GetBounds() const noexcept {
+					return Trace::AABB{ glm::vec3(static_cast<float>(-radius)), glm::vec3(static_cast<float>(radius)) };
+				}
+			};
+
+			// Box around the origin, with its edges rounded off by a radius (0 for
+			// sharp ones)
+			struct RoundBox {
+				glm::dvec3 extent;
+				double radius;
+
+				RoundBox(const glm::dvec3& extent, const double radius = 0.0) noexcept : extent(extent), radius(radius) {}
+
+				DONTDISCARD double operator()(const glm::dvec3& p) const noexcept {
+					const glm::dvec3 q = glm::abs(p) - extent + radius;
+
+					return glm::length(glm::max(q, 0.0)) + std::min(std::max(q.x, std::max(q.y, q.z)), 0.0) - radius;
+				}
+
+				DONTDISCARD Trace::AABB GetBounds() const noexcept {
+					return Trace::AABB{ -glm::vec3(extent), glm::vec3(extent) };
+				}
+			};
+
+			// Ring around the Z axis, of a tube of the minor radius swept along a
+			// circle of the major one
+			struct Torus {
+				double major, minor;
+
+				Torus(const double major, const double minor) noexcept : major(major), minor(minor) {}
+
+				DONTDISCARD double operator()(const glm::dvec3& p) const noexcept {
+					return glm::length(glm::dvec2(glm::length(glm::dvec2(p.x, p.y)) - major, p.z)) - minor;
+				}
+
+				DONTDISCARD Trace::AABB GetBounds() const noexcept {
+					const float outer = static_cast<float>(major + minor);
+
+					return Trace::AABB{ glm::vec3(-outer, -outer, static_cast<float>(-minor)), glm::vec3(outer, outer, static_cast<float>(minor)) };
+				}
+			};
+
+			// The power 8 (by default) Mandelbulb fractal, through its distance
+			// estimator. More iterations give finer detail, at a higher cost
+			struct Mandelbulb {
+				double power;
+				unsigned iterations;
+
+				Mandelbulb(const double power = 8.0, const unsigned iterations = 8) noexcept : power(power), iterations(iterations) {}
+
+				DONTDISCARD double operator()(const glm::dvec3& p) const noexcept {
+					glm::dvec3 z = p;
+					double derivative = 1.0, r = 0.0;
+
+					for (unsigned i = 0; i < iterations; i++) {
+						r = glm::length(z);
+
+						//If the point escapes (or sits right on the center), stop iterating
+						if (r > 2.0 || r == 0.0) break;
+
+						const double theta = std::acos(z.z / r) * power, phi = std::atan2(z.y, z.x) * power;
+						const double scaled = std::pow(r, power - 1.0);
+
+						derivative = scaled * power * derivative + 1.0;
+						z = scaled * r * glm::dvec3(std::sin(theta) * std::cos(phi), std::sin(theta) * std::sin(phi), std::cos(theta)) + p;
+					}
+
+					return r > 0.0 ? 0.5 * std::log(r) * r / derivative : 0.0;
+				}
+
+				DONTDISCARD Trace::AABB GetBounds() const noexcept {
+					return Trace::AABB{ glm::vec3(-1.2f), glm::vec3(1.2f) };
+				}
+			};
+
+			// Moves a node by an offset
+			template<typename A>
+			struct Translate {
+				A a;
+				glm::dvec3 offset;
+
+				Translate(A a, const glm::dvec3& offset) noexcept : a(std::move(a)), offset(offset) {}
+
+				DONTDISCARD double operator()(const glm::dvec3& p) const noexcept {
+					return a(p - offset);
+				}
+
+				DONTDISCARD Trace::AABB GetBounds() const noexcept {
+					const Trace::AABB bounds = a.GetBounds();
+
+					return Trace::AABB{ bounds.min + glm::vec3(offset), bounds.max + glm::vec3(offset) };
+				}
+			};
+
+			// Everything inside either node
+			template<typename A, typename B>
+			struct Union {
+				A a;
+				B b;
+
+				Union(A a, B b) noexcept : a(std::move(a)), b(std::move(b)) {}
+
+				DONTDISCARD double operator()(const glm::dvec3& p) const noexcept {
+					return std::min(a(p), b(p));
+				}
+
+				DONTDISCARD Trace::AABB GetBounds() const noexcept {
+					Trace::AABB bounds = a.GetBounds();
+
+					bounds.Grow(b.GetBounds());
+					return bounds;
+				}
+			};
+
+			// Everything inside both nodes
+			template<typename A, typename B>
+			struct Intersection {
+				A a;
+				B b;
+
+				Intersection(A a, B b) noexcept : a(std::move(a)), b(std::move(b)) {}
+
+				DONTDISCARD double operator()(const glm::dvec3& p) const noexcept {
+					return std::max(a(p), b(p));
+				}
+
+				DONTDISCARD Trace::AABB GetBounds() const noexcept {
+					const Trace::AABB boundsA = a.GetBounds(), boundsB = b.GetBounds();
+
+					return Trace::AABB{ glm::max(boundsA.min, boundsB.min), glm::min(boundsA.max, boundsB.max) };
+				}
+			};
+
+			// Everything inside the first node but not the second
+			template<typename A, typename B>
+			struct Subtraction {
+				A a;
+				B b;
+
+				Subtraction(A a, B b) noexcept : a(std::move(a)), b(std::move(b)) {}
+
+				DONTDISCARD double operator()(const glm::dvec3& p) const noexcept {
+					return std::max(a(p), -b(p));
+				}
+
+				DONTDISCARD Trace::AABB GetBounds() const noexcept {
+					return a.GetBounds();
+				}
+			};
+
+			// Union blending both nodes together where they are closer than the
+			// smoothness to each other (polynomial smooth minimum)
+			template<typename A, typename B>
+			struct SmoothUnion {
+				A a;
+				B b;
+				double smoothness;
+
+				SmoothUnion(A a, B b, const double smoothness) noexcept : a(std::move(a)), b(std::move(b)), smoothness(smoothness) {}
+
+				DONTDISCARD double operator()(const glm::dvec3& p) const noexcept {
+					const double distanceA = a(p), distanceB = b(p);
+					const double h = std::clamp(0.5 + 0.5 * (distanceB - distanceA) / smoothness, 0.0, 1.0);
+
+					return distanceB + (distanceA - distanceB) * h - smoothness * h * (1.0 - h);
+				}
+
+				// The blend bulges out of the union by up to a quarter of the smoothness
+				DONTDISCARD Trace::AABB GetBounds() const noexcept {
+					Trace::AABB bounds = a.GetBounds();
+
+					bounds.Grow(b.GetBounds());
+					bounds.min -= static_cast<float>(smoothness * 0.25);
+					bounds.max += static_cast<float>(smoothness * 0.25);
+					return bounds;
+				}
+			};
+
+			// ------------------------------------------------------------------------
+			/*! March
+			*
+			*   Sphere traces a field along a ray, from t on until tMax. Every step
+			*	goes as far as the distance to the surface, which can't be crossed on
+			*	the way. Gives back on t the first point closer to the surface than
+			*	the precision, if any is found within the steps given
+			*/ // ---------------------------------------------------------------------
+			template<typename Distance>
+			DONTDISCARD bool March(const Distance& distance, const glm::dvec3& origin, const glm::dvec3& direction, double& t,
+				const double tMax, const unsigned maxSteps, const double precision) noexcept {
+				for (unsigned i = 0; i < maxSteps && t <= tMax; i++) {
+					const double step = std::abs(distance(origin + direction * t));
+
+					//If we are close enough to the surface, we hit it
+					if (step < precision) return true;
+
+					t += step;
+				}
+
+				return false;
+			}
+
+			// ------------------------------------------------------------------------
+			/*! Get Normal
+			*
+			*   Returns the normal of a field at a point, through its gradient sampled
+			*	on the corners of a tetrahedron (four evaluations instead of six)
+			*/ // ---------------------------------------------------------------------
+			template<typename Distance>
+			DONTDISCARD glm::dvec3 GetNormal(const Distance& distance, const glm::dvec3& p, const double h) noexcept {
+				const glm::dvec3 k0(1.0, -1.0, -1.0), k1(-1.0, -1.0, 1.0), k2(-1.0, 1.0, -1.0), k3(1.0, 1.0, 1.0);
+
+				return glm::normalize(k0 * distance(p + k0 * h) + k1 * distance(p + k1 * h) + k2 * distance(p + k2 * h) + k3 * distance(p + k3 * h));
+			}
+
+			class Field {
+			#pragma region //Declarations
+				// The tree behind a Field. Marching and normals live here too, so those
+				//	of a fixed tree run specialized for its type, not a call per sample
+				struct Node {
+					virtual ~Node() noexcept = default;
+					DONTDISCARD virtual double Evaluate(const glm::dvec3& p) const noexcept = 0;
+					DONTDISCARD virtual Trace::AABB GetBounds() const noexcept = 0;
+					DONTDISCARD virtual bool March(const glm::dvec3& origin, const glm::dvec3& direction, double& t,
+						const double tMax, const unsigned maxSteps, const double precision) const noexcept = 0;
+					DONTDISCARD virtual glm::dvec3 GetNormal(const glm::dvec3& p, const double h) const noexcept = 0;
+				};
+
+				template<typename T>
+				struct Model final : Node {
+					T mTree;
+
+					Model(T tree) noexcept : mTree(std::move(tree)) {}
+
+					DONTDISCARD double Evaluate(const glm::dvec3& p) const noexcept override {
+						return mTree(p);
+					}
+
+					DONTDISCARD Trace::AABB GetBounds() const noexcept override {
+						return mTree.GetBounds();
+					}
+
+					DONTDISCARD bool March(const glm::dvec3& origin, const glm::dvec3& direction, double& t,
+						const double tMax, const unsigned maxSteps, const double precision) const noexcept override {
+						return SDF::March(mTree, origin, direction, t, tMax, maxSteps, precision);
+					}
+
+					DONTDISCARD glm::dvec3 GetNormal(const glm::dvec3& p, const double h) const noexcept override {
+						return SDF::GetNormal(mTree, p, h);
+					}
+				};
+			#pragma endregion
+
+			#pragma region //Constructors & Destructors
+			public:
+				template<typename T, typename = std::enable_if_t<!std::is_same_v<std::decay_t<T>, Field>>>
+				Field(T tree) :
+					mNode(std::make_shared<const Model<T>>(std::move(tree))) {}
+			#pragma endregion
+
+			#pragma region //Methods
+				DONTDISCARD double operator()(const glm::dvec3& p) const noexcept {
+					return mNode->Evaluate(p);
+				}
+
+				DONTDISCARD Trace::AABB GetBounds() const noexcept {
+					return mNode->GetBounds();
+				}
+
+				DONTDISCARD bool March(const glm::dvec3& origin, const glm::dvec3& direction, double& t,
+					const double tMax, const unsigned maxSteps, const double precision) const noexcept {
+					return mNode->March(origin, direction, t, tMax, maxSteps, precision);
+				}
+
+				DONTDISCARD glm::dvec3 GetNormal(const glm::dvec3& p, const double h) const noexcept {
+					return mNode->GetNormal(p, h);
+				}
+			#pragma endregion
+
+			#pragma region //Members
+			private:
+				std::shared_ptr<const Node> mNode;
+			#pragma endregion
+			};
+		}
+	}
+}
+
+#endif
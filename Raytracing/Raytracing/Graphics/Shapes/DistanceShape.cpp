@@ -0,0 +1,83 @@
+//
+//	DistanceShape.cpp
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 30/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#include "DistanceShape.h"
+
+namespace Graphics {
+	namespace Shapes {
+		namespace {
+			// Rays starting closer to the surface than this many times the precision
+			//	are taken to leave it (as reflected ones do), and stepped away first
+			constexpr double cSurfaceClearance = 2.0;
+		}
+
+		// ------------------------------------------------------------------------
+		/*! Custom Constructor
+		*
+		*   Constructs the surface of a distance field, sphere traced in up to
+		*	maxSteps steps down to the precision given (in the space of the field).
+		*	The bounds of the field are padded by the precision, and a little more
+		*	for them being single precision
+		*/ // ---------------------------------------------------------------------
+		DistanceShape::DistanceShape(SDF::Field field, const unsigned maxSteps, const double precision) noexcept :
+			mField(std::move(field)), mBounds(mField.GetBounds()), mMaxSteps(maxSteps), mPrecision(precision) {
+			const glm::vec3 padding = (mBounds.max - mBounds.min) * 1e-6f + static_cast<float>(precision);
+
+			mBounds.min -= padding;
+			mBounds.max += padding;
+		}
+
+		// ------------------------------------------------------------------------
+		/*! Destructor
+		*
+		*  
+		*/ // ---------------------------------------------------------------------
+		DistanceShape::~DistanceShape() noexcept {}
+
+		// ------------------------------------------------------------------------
+		/*! Test Intersection
+		*
+		*   Tests whether a ray intersects with the shape, marching only through
+		*	the stretch of it within the bounds of the field. Rays starting on the
+		*	surface step off it with growing steps, so they don't hit where they start
+		*/ // ---------------------------------------------------------------------
+		bool DistanceShape::TestIntersection(const Trace::Ray& ray, glm::dvec3& inpoint, glm::dvec3& innormal, glm::dvec3& outcolor) noexcept {
+			const Trace::Ray backray = mTransform.InverseTransformRay(ray);
+			const glm::dvec3 origin = backray.GetOrigin();
+			const glm::dvec3 direction = glm::normalize(backray.GetEndPoint() - origin);
+			double t, tExit;
+
+			//If the ray misses the bounds, there is no hit
+			if (!HitsLocalBounds(mBounds, origin, direction, t, tExit)) return false;
+
+			//If the ray starts on the surface, step it off first
+			if (std::abs(mField(origin)) < cSurfaceClearance * mPrecision)
+				for (double step = mPrecision; t <= tExit && std::abs(mField(origin + direction * t)) < cSurfaceClearance * mPrecision; step *= 2.0)
+					t += step;
+
+			//If the ray goes through without getting to the surface, there is no hit
+			if (!mField.March(origin, direction, t, tExit, mMaxSteps, mPrecision)) return false;
+
+			const glm::dvec3 point = origin + direction * t;
+
+			inpoint = mTransform.ApplyTransform(point);
+			innormal = glm::normalize(mTransform.ApplyTransform(mField.GetNormal(point, mPrecision)) - mTransform.ApplyTransform(glm::dvec3(0.0)));
+			outcolor = mColor;
+			return true;
+		}
+
+		// ------------------------------------------------------------------------
+		/*! Get Local Bounds
+		*
+		*   Returns the box around the field, before the transform
+		*/ // ---------------------------------------------------------------------
+		Trace::AABB DistanceShape::GetLocalBounds() const noexcept {
+			return mBounds;
+		}
+	}
+}
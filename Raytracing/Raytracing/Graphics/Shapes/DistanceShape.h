@@ -0,0 +1,50 @@
+//
+//	DistanceShape.h
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 30/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#ifndef _DISTANCE_SHAPE__H_
+#define _DISTANCE_SHAPE__H_
+
+#include "DistanceField.h"
+#include "../../Composition/Object.h"
+
+namespace Graphics {
+	namespace Shapes {
+		class DistanceShape : public Composition::Object {
+#pragma region //Constructors & Destructors
+		public:
+			DistanceShape(SDF::Field field, const unsigned maxSteps = 128, const double precision = 1e-4) noexcept;
+			virtual ~DistanceShape() noexcept;
+#pragma endregion
+
+#pragma region //Methods
+			bool TestIntersection(const Trace::Ray& ray, glm::dvec3& inpoint, glm::dvec3& innormal, glm::dvec3& outcolor) noexcept override;
+			DONTDISCARD Trace::AABB GetLocalBounds() const noexcept override;
+			DONTDISCARD inline const SDF::Field& GetField() const noexcept;
+#pragma endregion
+
+#pragma region //Members
+		private:
+			SDF::Field mField;
+			Trace::AABB mBounds;
+			unsigned mMaxSteps;
+			double mPrecision;
+#pragma endregion
+		};
+
+		// ------------------------------------------------------------------------
+		/*! Get Field
+		*
+		*   Returns the distance field the shape is the surface of
+		*/ // ---------------------------------------------------------------------
+		const SDF::Field& DistanceShape::GetField() const noexcept {
+			return mField;
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,620 @@
+//
+//	Mesh.cpp
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 25/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#include "Mesh.h"
+#include <charconv>
+#include <chrono>
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+namespace Graphics {
+	namespace Shapes {
+		namespace {
+			constexpr std::size_t cChunkSize = 1 << 20;
+
+			// Buffered reads from a binary file, refilled a chunk at a time
+			class ChunkReader {
+			public:
+				// ------------------------------------------------------------------------
+				/*! Custom Constructor
+				*
+				*   Reads from the current position of the stream on
+				*/ // ---------------------------------------------------------------------
+				ChunkReader(std::istream& stream) :
+					mStream{ stream }, mBuffer(cChunkSize), mBegin{ 0 }, mEnd{ 0 } {}
+
+				// ------------------------------------------------------------------------
+				/*! Take
+				*
+				*   Returns the next bytes of the file, which stay valid until the
+				*	next call
+				*/ // ---------------------------------------------------------------------
+				const char* Take(const std::size_t size) {
+					if (mEnd - mBegin < size) {
+						std::memmove(mBuffer.data(), mBuffer.data() + mBegin, mEnd - mBegin);
+						mEnd -= mBegin;
+						mBegin = 0;
+						if (mBuffer.size() < size) mBuffer.resize(size);
+						mStream.read(mBuffer.data() + mEnd, mBuffer.size() - mEnd);
+						mEnd += static_cast<std::size_t>(mStream.gcount());
+
+						//If the file ends before the data does, it was cut short
+						if (mEnd < size) throw Mesh::MeshException("Truncated PLY file");
+					}
+
+					const char* data = mBuffer.data() + mBegin;
+					mBegin += size;
+					return data;
+				}
+
+			private:
+				std::istream& mStream;
+				std::vector<char> mBuffer;
+				std::size_t mBegin, mEnd;
+			};
+
+			// Scalar types a PLY property may have
+			enum class PlyType {
+				Int8, UInt8, Int16, UInt16, Int32, UInt32, Float32, Float64
+			};
+
+			// Property of a PLY element. Lists store the type of their count apart
+			struct PlyProperty {
+				std::string name;
+				PlyType type;
+				bool list;
+				PlyType countType;
+			};
+
+			// Element of a PLY file, as declared by its header
+			struct PlyElement {
+				std::string name;
+				std::size_t count;
+				std::vector<PlyProperty> properties;
+			};
+
+			// ------------------------------------------------------------------------
+			/*! Parse PLY Type
+			*
+			*   Returns the type behind a PLY type name, old or new style
+			*/ // ---------------------------------------------------------------------
+			PlyType ParsePlyType(const std::string& name) {
+				if (name == "char" || name == "int8") return PlyType::Int8;
+				if (name == "uchar" || name == "uint8") return PlyType::UInt8;
+				if (name == "short" || name == "int16") return PlyType::Int16;
+				if (name == "ushort" || name == "uint16") return PlyType::UInt16;
+				if (name == "int" || name == "int32") return PlyType::Int32;
+				if (name == "uint" || name == "uint32") return PlyType::UInt32;
+				if (name == "float" || name == "float32") return PlyType::Float32;
+				if (name == "double" || name == "float64") return PlyType::Float64;
+
+				throw Mesh::MeshException("Unknown PLY property type");
+			}
+
+			// ------------------------------------------------------------------------
+			/*! Get Size
+			*
+			*   Returns the number of bytes a PLY scalar takes
+			*/ // ---------------------------------------------------------------------
+			std::size_t GetSize(const PlyType type) noexcept {
+				switch (type) {
+				case PlyType::Int8: case PlyType::UInt8: return 1;
+				case PlyType::Int16: case PlyType::UInt16: return 2;
+				case PlyType::Float64: return 8;
+				default: return 4;
+				}
+			}
+
+			// ------------------------------------------------------------------------
+			/*! Read Scalar
+			*
+			*   Decodes a PLY scalar, swapping its bytes if the file's endianness
+			*	is not the machine's
+			*/ // ---------------------------------------------------------------------
+			double ReadScalar(const char* data, const PlyType type, const bool swap) noexcept {
+				char bytes[8];
+				const std::size_t size = GetSize(type);
+
+				for (std::size_t i = 0; i < size; i++) bytes[i] = data[swap ? size - 1 - i : i];
+
+				switch (type) {
+				case PlyType::Int8: { std::int8_t v; std::memcpy(&v, bytes, 1); return v; }
+				case PlyType::UInt8: { std::uint8_t v; std::memcpy(&v, bytes, 1); return v; }
+				case PlyType::Int16: { std::int16_t v; std::memcpy(&v, bytes, 2); return v; }
+				case PlyType::UInt16: { std::uint16_t v; std::memcpy(&v, bytes, 2); return v; }
+				case PlyType::Int32: { std::int32_t v; std::memcpy(&v, bytes, 4); return v; }
+				case PlyType::UInt32: { std::uint32_t v; std::memcpy(&v, bytes, 4); return v; }
+				case PlyType::Float32: { float v; std::memcpy(&v, bytes, 4); return v; }
+				default: { double v; std::memcpy(&v, bytes, 8); return v; }
+				}
+			}
+
+			// ------------------------------------------------------------------------
+			/*! Skip Spaces
+			*
+			*   Moves past blanks within a line
+			*/ // ---------------------------------------------------------------------
+			const char* SkipSpaces(const char* it, const char* end) noexcept {
+				while (it < end && (*it == ' ' || *it == '\t' || *it == '\r')) it++;
+				return it;
+			}
+
+			// ------------------------------------------------------------------------
+			/*! Parse Vector
+			*
+			*   Parses the three numbers of an OBJ "v" or "vn" line
+			*/ // ---------------------------------------------------------------------
+			glm::vec3 ParseVector(const char* it, const char* end) {
+				glm::vec3 value;
+
+				for (int i = 0; i < 3; i++) {
+					it = SkipSpaces(it, end);
+
+					const auto parsed = std::from_chars(it, end, value[i]);
+
+					//If there aren't three numbers, the line is broken
+					if (parsed.ec != std::errc()) throw Mesh::MeshException("Invalid OBJ vector");
+
+					it = parsed.ptr;
+				}
+
+				return value;
+			}
+
+			// ------------------------------------------------------------------------
+			/*! Resolve Index
+			*
+			*   Turns a one based (or, if negative, relative to the end) OBJ index
+			*	into a zero based one
+			*/ // ---------------------------------------------------------------------
+			std::uint32_t ResolveIndex(const long long index, const std::size_t count) {
+				const long long resolved = index < 0 ? static_cast<long long>(count) + index : index - 1;
+
+				//If the index points outside of what has been read, the face is broken
+				if (resolved < 0 || resolved >= static_cast<long long>(count)) throw Mesh::MeshException("OBJ index out of range");
+
+				return static_cast<std::uint32_t>(resolved);
+			}
+
+			// ------------------------------------------------------------------------
+			/*! Hash
+			*
+			*   Mixes some bytes into a hash, eight at a time. It only has to tell
+			*	meshes apart, not resist anyone trying to collide them
+			*/ // ---------------------------------------------------------------------
+			std::uint64_t Hash(const void* data, const std::size_t size, std::uint64_t hash) noexcept {
+				const char* bytes = static_cast<const char*>(data);
+
+				for (std::size_t i = 0; i < size; i += 8) {
+					std::uint64_t word = 0;
+
+					std::memcpy(&word, bytes + i, std::min<std::size_t>(8, size - i));
+					hash = (hash ^ word) * 0x9E3779B97F4A7C15ull;
+					hash ^= hash >> 29;
+				}
+
+				return (hash ^ size) * 0xBF58476D1CE4E5B9ull;
+			}
+		}
+
+		// ------------------------------------------------------------------------
+		/*! Custom Constructor
+		*
+		*   Loads a Mesh from an OBJ or binary PLY file, told apart by extension.
+		*	Polygons are split into triangle fans
+		*/ // ---------------------------------------------------------------------
+		Mesh::Mesh(const std::string& path) {
+			const std::string extension = path.size() >= 4 ? path.substr(path.size() - 4) : std::string();
+
+			if (extension == ".obj" || extension == ".OBJ") LoadOBJ(path);
+			else if (extension == ".ply" || extension == ".PLY") LoadPLY(path);
+			//If we don't know the format, there is nothing to load
+			else throw MeshException("Unsupported mesh file format");
+
+			BuildBVH();
+		}
+
+		// ------------------------------------------------------------------------
+		/*! Custom Constructor
+		*
+		*   Builds a Mesh out of indexed triangles. Normals are optional, and are
+		*	indexed on their own when given
+		*/ // ---------------------------------------------------------------------
+		Mesh::Mesh(std::vector<glm::vec3> positions, std::vector<glm::uvec3> triangles,
+			std::vector<glm::vec3> normals, std::vector<glm::uvec3> normalTriangles) :
+			mPositions{ std::move(positions) }, mNormals{ std::move(normals) }, mTriangles{ std::move(triangles) },
+			mNormalTriangles{ std::move(normalTriangles) } {
+			//If the normals don't come with an index per corner, they can't be used
+			if (!mNormalTriangles.empty() && mNormalTriangles.size() != mTriangles.size())
+				throw MeshException("Every triangle needs its normal indices");
+
+			BuildBVH();
+		}
+
+		// ------------------------------------------------------------------------
+		/*! Intersect
+		*
+		*   Finds the closest triangle a ray hits before tMax. Triangles are
+		*	tested in a space sheared so the ray runs along +Z (Woop et al.), which
+		*	is watertight: rays through shared edges or vertices can't slip
+		*	between the triangles that meet there
+		*/ // ---------------------------------------------------------------------
+		bool Mesh::Intersect(const glm::dvec3& origin, const glm::dvec3& direction, const double tMax, Hit& hit) const noexcept {
+			const glm::dvec3 absDir = glm::abs(direction);
+			const int kz = absDir.x > absDir.y ? (absDir.x > absDir.z ? 0 : 2) : (absDir.y > absDir.z ? 1 : 2);
+			int kx = (kz + 1) % 3, ky = (kx + 1) % 3;
+
+			// Keep the winding of the triangles after the permutation
+			if (direction[kz] < 0.0) std::swap(kx, ky);
+
+			const double sx = direction[kx] / direction[kz], sy = direction[ky] / direction[kz], sz = 1.0 / direction[kz];
+			const double tMin = mEpsilon / glm::length(direction);
+			double closest = tMax;
+
+			const bool found = mBVH.Intersect(origin, direction, closest, [&](const std::uint32_t triangle, double& t) {
+				const glm::uvec3& corners = mTriangles[triangle];
+				const glm::dvec3 a = glm::dvec3(mPositions[corners.x]) - origin;
+				const glm::dvec3 b = glm::dvec3(mPositions[corners.y]) - origin;
+				const glm::dvec3 c = glm::dvec3(mPositions[corners.z]) - origin;
+				const double ax = a[kx] - sx * a[kz], ay = a[ky] - sy * a[kz];
+				const double bx = b[kx] - sx * b[kz], by = b[ky] - sy * b[kz];
+				const double cx = c[kx] - sx * c[kz], cy = c[ky] - sy * c[kz];
+				const double u = cx * by - cy * bx, v = ax * cy - ay * cx, w = bx * ay - by * ax;
+
+				//If the edge functions disagree on the side, the ray passes by
+				if ((u < 0.0 || v < 0.0 || w < 0.0) && (u > 0.0 || v > 0.0 || w > 0.0)) return false;
+
+				const double det = u + v + w;
+
+				//If the triangle is seen edge on, there is nothing to hit
+				if (det == 0.0) return false;
+
+				const double distance = (u * sz * a[kz] + v * sz * b[kz] + w * sz * c[kz]) / det;
+
+				//If the hit is behind the ray (or its own surface) or beyond the closest one, it doesn't count
+				if (distance <= tMin || distance >= t) return false;
+
+				t = distance;
+				hit = { distance, triangle, v / det, w / det };
+				return true;
+			});
+
+			return found;
+		}
+
+		// ------------------------------------------------------------------------
+		/*! Get Normal
+		*
+		*   Returns the normal at a hit, interpolated from the corners if they
+		*	all have one, the one of the face otherwise
+		*/ // ---------------------------------------------------------------------
+		glm::dvec3 Mesh::GetNormal(const Hit& hit) const noexcept {
+			if (!mNormalTriangles.empty()) {
+				const glm::uvec3& corners = mNormalTriangles[hit.triangle];
+
+				if (corners.x != cNoNormal && corners.y != cNoNormal && corners.z != cNoNormal) {
+					const glm::dvec3 normal = glm::dvec3(mNormals[corners.x]) * (1.0 - hit.u - hit.v) +
+						glm::dvec3(mNormals[corners.y]) * hit.u + glm::dvec3(mNormals[corners.z]) * hit.v;
+
+					if (glm::dot(normal, normal) > 0.0) return glm::normalize(normal);
+				}
+			}
+
+			const glm::uvec3& corners = mTriangles[hit.triangle];
+			const glm::dvec3 a(mPositions[corners.x]);
+
+			return glm::normalize(glm::cross(glm::dvec3(mPositions[corners.y]) - a, glm::dvec3(mPositions[corners.z]) - a));
+		}
+
+		// ------------------------------------------------------------------------
+		/*! Load OBJ
+		*
+		*   Streams the positions, normals and faces out of an OBJ file, a chunk
+		*	at a time. Everything else (texture coordinates, groups, materials)
+		*	is skipped
+		*/ // ---------------------------------------------------------------------
+		void Mesh::LoadOBJ(const std::string& path) {
+			std::ifstream file(path, std::ios::binary);
+
+			//If we can't open the file, there is nothing to load
+			if (!file) throw MeshException("Failed to open mesh file");
+
+			std::vector<char> buffer(cChunkSize);
+			std::vector<std::uint32_t> polygon, polygonNormals;
+			std::size_t carried = 0;
+			bool hasNormals = false;
+
+			const auto parseLine = [&](const char* it, const char* end) {
+				it = SkipSpaces(it, end);
+
+				if (end - it < 2 || (it[1] != ' ' && it[1] != '\t' && (it[0] != 'v' || it[1] != 'n'))) return;
+
+				if (it[0] == 'v' && it[1] == 'n') mNormals.push_back(ParseVector(it + 2, end));
+				else if (it[0] == 'v') mPositions.push_back(ParseVector(it + 1, end));
+				else if (it[0] == 'f') {
+					polygon.clear();
+					polygonNormals.clear();
+
+					// Every corner is "v", "v/vt", "v//vn" or "v/vt/vn"
+					for (it = SkipSpaces(it + 1, end); it < end; it = SkipSpaces(it, end)) {
+						long long index = 0;
+						const auto parsed = std::from_chars(it, end, index);
+
+						//If a corner has no position, the face is broken
+						if (parsed.ec != std::errc()) throw MeshException("Invalid OBJ face");
+
+						polygon.push_back(ResolveIndex(index, mPositions.size()));
+						polygonNormals.push_back(cNoNormal);
+						it = parsed.ptr;
+
+						for (int slot = 1; slot < 3 && it < end && *it == '/'; slot++) {
+							const auto next = std::from_chars(++it, end, index);
+
+							if (next.ec == std::errc()) {
+								if (slot == 2) polygonNormals.back() = ResolveIndex(index, mNormals.size());
+								it = next.ptr;
+							}
+						}
+
+						while (it < end && *it != ' ' && *it != '\t' && *it != '\r') it++;
+					}
+
+					for (std::size_t i = 2; i < polygon.size(); i++) {
+						const glm::uvec3 normals(polygonNormals[0], polygonNormals[i - 1], polygonNormals[i]);
+
+						mTriangles.emplace_back(polygon[0], polygon[i - 1], polygon[i]);
+						hasNormals |= normals.x != cNoNormal || normals.y != cNoNormal || normals.z != cNoNormal;
+						mNormalTriangles.push_back(normals);
+					}
+				}
+			};
+
+			// Lines cut by the end of a chunk are carried over to the next one
+			for (;;) {
+				file.read(buffer.data() + carried, buffer.size() - carried);
+
+				const std::size_t size = carried + static_cast<std::size_t>(file.gcount());
+				const char* begin = buffer.data();
+				const char* end = begin + size;
+
+				if (!size) break;
+
+				for (const char* newline; (newline = static_cast<const char*>(std::memchr(begin, '\n', end - begin))); begin = newline + 1)
+					parseLine(begin, newline);
+
+				if (!file) {
+					parseLine(begin, end);
+					break;
+				}
+
+				carried = end - begin;
+
+				//If a single line doesn't fit in a chunk, make room for it
+				if (carried == buffer.size()) buffer.resize(buffer.size() * 2);
+
+				std::memmove(buffer.data(), begin, carried);
+			}
+
+			if (!hasNormals) {
+				mNormals.clear();
+				mNormalTriangles.clear();
+			}
+		}
+
+		// ------------------------------------------------------------------------
+		/*! Load PLY
+		*
+		*   Reads the vertices (and their normals, if any) and faces of a binary
+		*	PLY file, of either endianness
+		*/ // ---------------------------------------------------------------------
+		void Mesh::LoadPLY(const std::string& path) {
+			std::ifstream file(path, std::ios::binary);
+
+			//If we can't open the file, there is nothing to load
+			if (!file) throw MeshException("Failed to open mesh file");
+
+			std::vector<PlyElement> elements;
+			std::string line, format;
+
+			//If the file does not start with the magic number, it is no PLY
+			if (!std::getline(file, line) || line.compare(0, 3, "ply")) throw MeshException("Invalid PLY file");
+
+			while (std::getline(file, line) && line.compare(0, 10, "end_header")) {
+				std::istringstream tokens(line);
+				std::string keyword;
+
+				tokens >> keyword;
+
+				if (keyword == "format") tokens >> format;
+				else if (keyword == "element") {
+					elements.emplace_back();
+					tokens >> elements.back().name >> elements.back().count;
+				} else if (keyword == "property" && !elements.empty()) {
+					std::string type;
+					PlyProperty property{};
+
+					tokens >> type;
+
+					if (type == "list") {
+						std::string countType, itemType;
+
+						tokens >> countType >> itemType;
+						property.list = true;
+						property.countType = ParsePlyType(countType);
+						property.type = ParsePlyType(itemType);
+					} else
+						property.type = ParsePlyType(type);
+
+					tokens >> property.name;
+					elements.back().properties.push_back(property);
+				}
+			}
+
+			//If the data is text, or the header never ends, we can't stream it
+			if (!file || (format != "binary_little_endian" && format != "binary_big_endian"))
+				throw MeshException("Only binary PLY files are supported");
+
+			const std::uint16_t probe = 1;
+			const bool littleEndian = *reinterpret_cast<const std::uint8_t*>(&probe) == 1;
+			const bool swap = littleEndian != (format == "binary_little_endian");
+			ChunkReader reader(file);
+			std::vector<std::uint32_t> polygon;
+
+			for (const PlyElement& element : elements) {
+				// Where x, y, z, nx, ny and nz sit within the element (-1 if missing), and their types
+				const char* names[6] = { "x", "y", "z", "nx", "ny", "nz" };
+				int offsets[6] = { -1, -1, -1, -1, -1, -1 };
+				PlyType types[6] = {};
+				std::size_t stride = 0;
+				bool fixed = true;
+
+				for (const PlyProperty& property : element.properties) {
+					for (int k = 0; k < 6; k++)
+						if (!property.list && property.name == names[k]) {
+							offsets[k] = static_cast<int>(stride);
+							types[k] = property.type;
+						}
+
+					fixed &= !property.list;
+					stride += GetSize(property.type);
+				}
+
+				if (element.name == "vertex" && fixed) {
+					const bool hasNormals = offsets[3] >= 0 && offsets[4] >= 0 && offsets[5] >= 0;
+
+					//If the vertices have no position, there is no mesh
+					if (offsets[0] < 0 || offsets[1] < 0 || offsets[2] < 0) throw MeshException("PLY vertices have no position");
+
+					mPositions.reserve(element.count);
+					if (hasNormals) mNormals.reserve(element.count);
+
+					for (std::size_t i = 0; i < element.count; i++) {
+						const char* vertex = reader.Take(stride);
+						glm::vec3 value;
+
+						for (int k = 0; k < 3; k++) value[k] = static_cast<float>(ReadScalar(vertex + offsets[k], types[k], swap));
+						mPositions.push_back(value);
+
+						if (hasNormals) {
+							for (int k = 0; k < 3; k++) value[k] = static_cast<float>(ReadScalar(vertex + offsets[k + 3], types[k + 3], swap));
+							mNormals.push_back(value);
+						}
+					}
+				} else {
+					const bool faces = element.name == "face";
+
+					for (std::size_t i = 0; i < element.count; i++)
+						for (const PlyProperty& property : element.properties) {
+							if (!property.list) {
+								(void)reader.Take(GetSize(property.type));
+								continue;
+							}
+
+							const std::size_t count = static_cast<std::size_t>(ReadScalar(reader.Take(GetSize(property.countType)), property.countType, swap));
+							const std::size_t size = GetSize(property.type);
+							const char* items = reader.Take(count * size);
+
+							//If the list isn't the corners of a face, it is of no use
+							if (!faces || (property.name != "vertex_indices" && property.name != "vertex_index")) continue;
+
+							polygon.resize(count);
+
+							for (std::size_t k = 0; k < count; k++) {
+								const double index = ReadScalar(items + k * size, property.type, swap);
+
+								//If a corner points outside of the vertices, the face is broken
+								if (index < 0.0 || index >= static_cast<double>(mPositions.size())) throw MeshException("PLY index out of range");
+
+								polygon[k] = static_cast<std::uint32_t>(index);
+							}
+
+							for (std::size_t k = 2; k < count; k++)
+								mTriangles.emplace_back(polygon[0], polygon[k - 1], polygon[k]);
+						}
+				}
+			}
+
+			// Per vertex normals share the indices of the positions
+			if (!mNormals.empty()) mNormalTriangles = mTriangles;
+		}
+
+		// ------------------------------------------------------------------------
+		/*! Build BVH
+		*
+		*   Builds the tree over the triangles, and the offset secondary rays need
+		*	to leave the surface they start on. The binary tree is only kept long
+		*	enough to collapse it into the wide one rays walk.
+		*	With a cache directory set, trees are saved there under the hash of
+		*	what they were built from, and mapped back from it by later runs
+		*	loading the same geometry
+		*/ // ---------------------------------------------------------------------
+		void Mesh::BuildBVH() {
+			const auto start = std::chrono::steady_clock::now();
+			std::vector<Trace::AABB> bounds(mTriangles.size());
+			Trace::AABB box;
+			Trace::BVH bvh;
+
+			for (std::size_t i = 0; i < mTriangles.size(); i++) {
+				const glm::uvec3& corners = mTriangles[i];
+
+				//If a triangle points outside of the vertices, the mesh is broken
+				if (corners.x >= mPositions.size() || corners.y >= mPositions.size() || corners.z >= mPositions.size())
+					throw MeshException("Triangle index out of range");
+
+				bounds[i].Grow(mPositions[corners.x]);
+				bounds[i].Grow(mPositions[corners.y]);
+				bounds[i].Grow(mPositions[corners.z]);
+				box.Grow(bounds[i]);
+			}
+
+			mEpsilon = mTriangles.empty() ? 0.0 : 1e-6 * glm::length(glm::dvec3(box.max - box.min));
+
+			const std::uint64_t key = mCacheDirectory.empty() ? 0 : GetKey();
+			std::string path;
+
+			if (!mCacheDirectory.empty()) {
+				char name[32];
+
+				std::snprintf(name, sizeof(name), "%016" PRIx64 ".bvh", key);
+				path = mCacheDirectory + "/" + name;
+			}
+
+			//If the same geometry was built before, its tree is used as it was saved
+			if (!path.empty() && mBVH.Load(path, key, static_cast<std::uint32_t>(mTriangles.size()))) {
+				mBuildTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+				return;
+			}
+
+			bvh.Build(bounds);
+			mBVH.Build(bvh);
+			mBuildTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+			//If the cache can't be written, the next run just builds the tree again
+			if (!path.empty()) try {
+				mBVH.Save(path, key);
+			} catch (const Trace::WideBVH::WideBVHException&) {}
+		}
+
+		// ------------------------------------------------------------------------
+		/*! Get Key
+		*
+		*   Returns the hash of everything the tree is built from: the positions
+		*	and triangles, and the builder they go through
+		*/ // ---------------------------------------------------------------------
+		std::uint64_t Mesh::GetKey() const noexcept {
+			const std::uint64_t settings = static_cast<std::uint64_t>(Trace::BVH::Builder::SAH) + 1;
+
+			return Hash(mTriangles.data(), mTriangles.size() * sizeof(glm::uvec3),
+				Hash(mPositions.data(), mPositions.size() * sizeof(glm::vec3), settings));
+		}
+	}
+}
@@ -0,0 +1,126 @@
+//
+//	Mesh.h
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 25/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#ifndef _MESH__H_
+#define _MESH__H_
+
+#include <string>
+#include <vector>
+#include "../../Trace/WideBVH.h"
+
+namespace Graphics {
+	namespace Shapes {
+		class Mesh {
+		#pragma region //Declarations
+		public:
+			CLASS_EXCEPTION(Mesh)
+
+			// Closest hit of a ray, in the space of the mesh
+			struct Hit {
+				double t;
+				std::uint32_t triangle;
+				double u, v;
+			};
+
+			// Normal index of the corners without one
+			static constexpr std::uint32_t cNoNormal = 0xFFFFFFFFu;
+		#pragma endregion
+
+		#pragma region //Constructors & Destructors
+			Mesh(const std::string& path);
+			Mesh(std::vector<glm::vec3> positions, std::vector<glm::uvec3> triangles,
+				std::vector<glm::vec3> normals = {}, std::vector<glm::uvec3> normalTriangles = {});
+		#pragma endregion
+
+		#pragma region //Methods
+			DONTDISCARD bool Intersect(const glm::dvec3& origin, const glm::dvec3& direction, const double tMax, Hit& hit) const noexcept;
+			DONTDISCARD glm::dvec3 GetNormal(const Hit& hit) const noexcept;
+			DONTDISCARD inline const std::vector<glm::vec3>& GetPositions() const noexcept;
+			DONTDISCARD inline const std::vector<glm::uvec3>& GetTriangles() const noexcept;
+			DONTDISCARD inline const Trace::WideBVH& GetBVH() const noexcept;
+			DONTDISCARD inline double GetBuildTime() const noexcept;
+			static inline void SetCacheDirectory(const std::string& directory);
+			DONTDISCARD static inline const std::string& GetCacheDirectory() noexcept;
+		private:
+			void LoadOBJ(const std::string& path);
+			void LoadPLY(const std::string& path);
+			void BuildBVH();
+			DONTDISCARD std::uint64_t GetKey() const noexcept;
+		#pragma endregion
+
+		#pragma region //Members
+			std::vector<glm::vec3> mPositions;
+			std::vector<glm::vec3> mNormals;
+			std::vector<glm::uvec3> mTriangles;
+			std::vector<glm::uvec3> mNormalTriangles;
+			Trace::WideBVH mBVH;
+			double mEpsilon;
+			double mBuildTime;
+			inline static std::string mCacheDirectory;
+		#pragma endregion
+		};
+
+		// ------------------------------------------------------------------------
+		/*! Get Positions
+		*
+		*   Returns the vertex positions of the Mesh
+		*/ // ---------------------------------------------------------------------
+		const std::vector<glm::vec3>& Mesh::GetPositions() const noexcept {
+			return mPositions;
+		}
+
+		// ------------------------------------------------------------------------
+		/*! Get Triangles
+		*
+		*   Returns the position indices of every triangle
+		*/ // ---------------------------------------------------------------------
+		const std::vector<glm::uvec3>& Mesh::GetTriangles() const noexcept {
+			return mTriangles;
+		}
+
+		// ------------------------------------------------------------------------
+		/*! Get BVH
+		*
+		*   Returns the tree over the triangles of the Mesh
+		*/ // ---------------------------------------------------------------------
+		const Trace::WideBVH& Mesh::GetBVH() const noexcept {
+			return mBVH;
+		}
+
+		// ------------------------------------------------------------------------
+		/*! Get Build Time
+		*
+		*   Returns how long the tree over the triangles took to build (or to map
+		*	back from the cache), in milliseconds
+		*/ // ---------------------------------------------------------------------
+		double Mesh::GetBuildTime() const noexcept {
+			return mBuildTime;
+		}
+
+		// ------------------------------------------------------------------------
+		/*! Set Cache Directory
+		*
+		*   Sets the directory built trees are kept in across runs, or none
+		*	(empty) to always build them
+		*/ // ---------------------------------------------------------------------
+		void Mesh::SetCacheDirectory(const std::string& directory) {
+			mCacheDirectory = directory;
+		}
+
+		// ------------------------------------------------------------------------
+		/*! Get Cache Directory
+		*
+		*   Returns the directory built trees are kept in across runs
+		*/ // ---------------------------------------------------------------------
+		const std::string& Mesh::GetCacheDirectory() noexcept {
+			return mCacheDirectory;
+		}
+	}
+}
+
+#endif
@@ -55,5 +55,14 @@ namespace Graphics {
 
 			return false;
 		}
+
+		// ------------------------------------------------------------------------
+		/*! Get Local Bounds
+		*
+		*   Returns the box around the unit square the plane is cut to
+		*/ // ---------------------------------------------------------------------
+		Trace::AABB Plane::GetLocalBounds() const noexcept {
+			return Trace::AABB{ glm::vec3(-1.f, -1.f, 0.f), glm::vec3(1.f, 1.f, 0.f) };
+		}
 	}
 }
\ No newline at end of file
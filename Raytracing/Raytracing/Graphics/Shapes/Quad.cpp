@@ -0,0 +1,96 @@
+//
+//	Quad.cpp
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 29/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#include "Quad.h"
+
+namespace Graphics {
+	namespace Shapes {
+		// ------------------------------------------------------------------------
+		/*! Default Constructor
+		*
+		*   Constructs the square from -1 to 1 on the XY plane, to be placed with
+		*	a transform like a Plane
+		*/ // ---------------------------------------------------------------------
+		Quad::Quad() noexcept {
+			Prepare();
+		}
+
+		// ------------------------------------------------------------------------
+		/*! Custom Constructor
+		*
+		*   Constructs the parallelogram spanned by two edges out of a world space
+		*	corner. Like Plane, it faces away from edgeU x edgeV
+		*/ // ---------------------------------------------------------------------
+		Quad::Quad(const glm::dvec3& corner, const glm::dvec3& edgeU, const glm::dvec3& edgeV) noexcept {
+			SetTransform(Math::Transform{ glm::dmat4(glm::dvec4(edgeU * 0.5, 0.0), glm::dvec4(edgeV * 0.5, 0.0),
+				glm::dvec4(glm::normalize(glm::cross(edgeU, edgeV)), 0.0), glm::dvec4(corner + (edgeU + edgeV) * 0.5, 1.0)) });
+		}
+
+		// ------------------------------------------------------------------------
+		/*! Destructor
+		*
+		*  
+		*/ // ---------------------------------------------------------------------
+		Quad::~Quad() noexcept {}
+
+		// ------------------------------------------------------------------------
+		/*! Set Transform
+		*
+		*   Sets the transform, and moves the plane of the shape to world space
+		*/ // ---------------------------------------------------------------------
+		void Quad::SetTransform(const Math::Transform& transform) noexcept {
+			Object::SetTransform(transform);
+			Prepare();
+		}
+
+		// ------------------------------------------------------------------------
+		/*! Test Intersection
+		*
+		*   Tests whether a ray intersects with the quad
+		*/ // ---------------------------------------------------------------------
+		bool Quad::TestIntersection(const Trace::Ray& ray, glm::dvec3& inpoint, glm::dvec3& innormal, glm::dvec3& outcolor) noexcept {
+			double u, v;
+
+			//If the plane is hit outside of the edges, the quad isn't
+			if (!IntersectPlane(ray, inpoint, u, v) || std::abs(u) > 1.0 || std::abs(v) > 1.0) return false;
+
+			innormal = mNormal;
+			outcolor = mColor;
+			return true;
+		}
+
+		// ------------------------------------------------------------------------
+		/*! Get Local Bounds
+		*
+		*   Returns the box around the unit square, before the transform
+		*/ // ---------------------------------------------------------------------
+		Trace::AABB Quad::GetLocalBounds() const noexcept {
+			return Trace::AABB{ glm::vec3(-1.f, -1.f, 0.f), glm::vec3(1.f, 1.f, 0.f) };
+		}
+
+		// ------------------------------------------------------------------------
+		/*! Prepare
+		*
+		*   Precomputes the plane in world space, and the vectors whose dot product
+		*	with a point on it gives its coordinates along the transformed edges
+		*/ // ---------------------------------------------------------------------
+		void Quad::Prepare() noexcept {
+			const glm::dmat4 forward = mTransform.GetForward();
+			const glm::dvec3 edgeU(forward[0]), edgeV(forward[1]);
+
+			mCenter = glm::dvec3(forward[3]);
+			mPlaneNormal = glm::cross(edgeU, edgeV);
+			mNormal = -glm::normalize(mPlaneNormal);
+
+			const glm::dvec3 w = mPlaneNormal / glm::dot(mPlaneNormal, mPlaneNormal);
+
+			mDualU = glm::cross(edgeV, w);
+			mDualV = glm::cross(w, edgeU);
+		}
+	}
+}
@@ -0,0 +1,71 @@
+//
+//	Quad.h
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 29/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#ifndef _QUAD__H_
+#define _QUAD__H_
+
+#include <glm/glm.hpp>
+#include "../../Composition/Object.h"
+
+namespace Graphics {
+	namespace Shapes {
+		class Quad : public Composition::Object {
+#pragma region //Constructors & Destructors
+		public:
+			Quad() noexcept;
+			Quad(const glm::dvec3& corner, const glm::dvec3& edgeU, const glm::dvec3& edgeV) noexcept;
+			virtual ~Quad() noexcept;
+#pragma endregion
+
+#pragma region //Methods
+			void SetTransform(const Math::Transform& transform) noexcept override;
+			bool TestIntersection(const Trace::Ray& ray, glm::dvec3& inpoint, glm::dvec3& innormal, glm::dvec3& outcolor) noexcept override;
+			DONTDISCARD Trace::AABB GetLocalBounds() const noexcept override;
+		protected:
+			DONTDISCARD inline bool IntersectPlane(const Trace::Ray& ray, glm::dvec3& point, double& u, double& v) const noexcept;
+		private:
+			void Prepare() noexcept;
+#pragma endregion
+
+#pragma region //Members
+		protected:
+			glm::dvec3 mCenter;
+			glm::dvec3 mNormal;
+			glm::dvec3 mPlaneNormal;
+			glm::dvec3 mDualU, mDualV;
+#pragma endregion
+		};
+
+		// ------------------------------------------------------------------------
+		/*! Intersect Plane
+		*
+		*   Intersects a ray with the plane of the shape, in world space. Gives
+		*	back the point hit and its coordinates along the two edges, from -1
+		*	to 1 within the unit square the transform places
+		*/ // ---------------------------------------------------------------------
+		bool Quad::IntersectPlane(const Trace::Ray& ray, glm::dvec3& point, double& u, double& v) const noexcept {
+			const glm::dvec3 direction = ray.GetEndPoint() - ray.GetOrigin();
+			const double denominator = glm::dot(mPlaneNormal, direction);
+
+			//If the ray runs parallel to the plane, it never gets to it
+			if (denominator == 0.0) return false;
+
+			const double t = glm::dot(mPlaneNormal, mCenter - ray.GetOrigin()) / denominator;
+
+			//If the plane is behind the ray, there is no hit
+			if (t <= 0.0) return false;
+
+			point = ray.GetOrigin() + direction * t;
+			u = glm::dot(point - mCenter, mDualU);
+			v = glm::dot(point - mCenter, mDualV);
+			return true;
+		}
+	}
+}
+
+#endif
@@ -65,5 +65,14 @@ namespace Graphics {
 			} else
 				return false;
 		}
+
+		// ------------------------------------------------------------------------
+		/*! Get Local Bounds
+		*
+		*   Returns the box around the unit sphere
+		*/ // ---------------------------------------------------------------------
+		Trace::AABB Sphere::GetLocalBounds() const noexcept {
+			return Trace::AABB{ glm::vec3(-1.f), glm::vec3(1.f) };
+		}
 	}
 }
\ No newline at end of file
@@ -23,6 +23,7 @@ namespace Graphics {
 
 		#pragma region //Methods
 			bool TestIntersection(const Trace::Ray& ray, glm::dvec3& inpoint, glm::dvec3& innormal, glm::dvec3& outcolor) noexcept override;
+			DONTDISCARD Trace::AABB GetLocalBounds() const noexcept override;
 		#pragma endregion
 		};
 	}
@@ -0,0 +1,67 @@
+//
+//	TriangleMesh.cpp
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 25/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#include "TriangleMesh.h"
+#include <limits>
+
+namespace Graphics {
+	namespace Shapes {
+		// ------------------------------------------------------------------------
+		/*! Custom Constructor
+		*
+		*   Constructs an object out of a Mesh, which any number of them may share
+		*/ // ---------------------------------------------------------------------
+		TriangleMesh::TriangleMesh(const std::shared_ptr<const Mesh>& mesh) :
+			mMesh{ mesh } {}
+
+		// ------------------------------------------------------------------------
+		/*! Destructor
+		*
+		*   Destroys the Triangle Mesh
+		*/ // ---------------------------------------------------------------------
+		TriangleMesh::~TriangleMesh() {}
+
+		// ------------------------------------------------------------------------
+		/*! Test Intersection
+		*
+		*   Tests whether a ray intersects with the mesh, through its BVH
+		*/ // ---------------------------------------------------------------------
+		bool TriangleMesh::TestIntersection(const Trace::Ray& ray, glm::dvec3& inpoint, glm::dvec3& innormal, glm::dvec3& outcolor) noexcept {
+			// Transform the ray into the object's space.
+			const Trace::Ray newRay = mTransform.InverseTransformRay(ray);
+			Mesh::Hit hit;
+
+			if (!mMesh->Intersect(newRay.GetOrigin(), newRay.GetEndPoint() - newRay.GetOrigin(), std::numeric_limits<double>::max(), hit))
+				return false;
+
+			// Normals go back through the inverse transpose, so they stay normal under any scale
+			inpoint = mTransform.ApplyTransform(newRay.GetOrigin() + ((newRay.GetEndPoint() - newRay.GetOrigin()) * hit.t));
+			innormal = glm::normalize(glm::dvec3(glm::transpose(mTransform.GetInverse()) * glm::dvec4(mMesh->GetNormal(hit), 0.0)));
+			outcolor = mColor;
+			return true;
+		}
+
+		// ------------------------------------------------------------------------
+		/*! Get Local Bounds
+		*
+		*   Returns the box around the triangles, shared by every instance of the mesh
+		*/ // ---------------------------------------------------------------------
+		Trace::AABB TriangleMesh::GetLocalBounds() const noexcept {
+			return mMesh->GetBVH().GetBounds();
+		}
+
+		// ------------------------------------------------------------------------
+		/*! Get Build Time
+		*
+		*   Returns how long the tree over the triangles of the mesh took to build
+		*/ // ---------------------------------------------------------------------
+		double TriangleMesh::GetBuildTime() const noexcept {
+			return mMesh->GetBuildTime();
+		}
+	}
+}
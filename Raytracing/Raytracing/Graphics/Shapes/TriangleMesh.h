@@ -0,0 +1,48 @@
+//
+//	TriangleMesh.h
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 25/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#ifndef _TRIANGLE_MESH__H_
+#define _TRIANGLE_MESH__H_
+
+#include "../../Composition/Object.h"
+#include "Mesh.h"
+
+namespace Graphics {
+	namespace Shapes {
+		class TriangleMesh : public Composition::Object {
+		#pragma region //Constructors & Destructors
+		public:
+			TriangleMesh(const std::shared_ptr<const Mesh>& mesh);
+			virtual ~TriangleMesh() override;
+		#pragma endregion
+
+		#pragma region //Methods
+			bool TestIntersection(const Trace::Ray& ray, glm::dvec3& inpoint, glm::dvec3& innormal, glm::dvec3& outcolor) noexcept override;
+			DONTDISCARD Trace::AABB GetLocalBounds() const noexcept override;
+			DONTDISCARD double GetBuildTime() const noexcept override;
+			DONTDISCARD inline const std::shared_ptr<const Mesh>& GetMesh() const noexcept;
+		#pragma endregion
+
+		#pragma region //Members
+		private:
+			std::shared_ptr<const Mesh> mMesh;
+		#pragma endregion
+		};
+
+		// ------------------------------------------------------------------------
+		/*! Get Mesh
+		*
+		*   Returns the geometry the object is made of
+		*/ // ---------------------------------------------------------------------
+		const std::shared_ptr<const Mesh>& TriangleMesh::GetMesh() const noexcept {
+			return mMesh;
+		}
+	}
+}
+
+#endif
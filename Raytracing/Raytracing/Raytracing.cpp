@@ -7,13 +7,54 @@
 //
 
 #include "Core/RaytracingApp.h"
+#include "Core/DatasetGenerator.h"
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
 
 // ------------------------------------------------------------------------
 /*! Main
 *
-*   Program Entrypoint
+*   Program Entrypoint. Opens the viewer, or renders a training dataset when
+*	called as: Raytracing --generate-dataset <directory> <count> [options]
 */ // ---------------------------------------------------------------------
-int main() {
+int main(int argc, char* argv[]) {
+	if (argc > 1 && !std::strcmp(argv[1], "--generate-dataset")) {
+		//If we don't know where and how much to render, there is nothing to do
+		if (argc < 4) {
+			std::cerr << "Usage: " << argv[0] << " --generate-dataset <directory> <count> [--split name] [--seed n]"
+				" [--crop size] [--half] [--aux] [--spp n] [--depth n]" << std::endl;
+			return 1;
+		}
+
+		try {
+			Core::DatasetSettings settings;
+			settings.directory = argv[2];
+			settings.count = std::stoull(argv[3]);
+
+			for (int i = 4; i < argc; i++) {
+				const std::string option = argv[i];
+
+				if (option == "--half") settings.format = Core::ShardFormat::Half;
+				else if (option == "--aux") settings.auxiliary = true;
+				else if (i + 1 < argc && option == "--split") settings.split = argv[++i];
+				else if (i + 1 < argc && option == "--seed") settings.seed = std::stoull(argv[++i]);
+				else if (i + 1 < argc && option == "--crop") settings.cropSize = std::stoull(argv[++i]);
+				else if (i + 1 < argc && option == "--spp") settings.samplesPerPixel = std::stoul(argv[++i]);
+				else if (i + 1 < argc && option == "--depth") settings.maxDepth = std::stoul(argv[++i]);
+				else throw std::invalid_argument("Unknown option " + option);
+			}
+
+			Core::DatasetGenerator(settings).Generate();
+		} catch (const std::exception& e) {
+			std::cerr << "Dataset generation failed: " << e.what() << std::endl;
+			return 1;
+		}
+
+		return 0;
+	}
+
 	Core::RaytracingApp app;
 	app.Execute();
 	return 0;
@@ -0,0 +1,395 @@
+//
+//	BVH.cpp
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 25/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#include "BVH.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <numeric>
+#include <thread>
+
+namespace Trace {
+	namespace {
+		constexpr int cBinCount = 16;
+		constexpr std::uint32_t cMaxDepth = 60;
+		constexpr float cTraversalCost = 1.f;
+
+		// Below these many primitives, splitting the work among threads costs more than it saves
+		constexpr std::uint32_t cParallelBinning = 1u << 16;
+		constexpr std::uint32_t cParallelTask = 1u << 12;
+
+		struct Bin {
+			AABB box;
+			std::uint32_t count = 0;
+		};
+
+		using Bins = std::array<std::array<Bin, cBinCount>, 3>;
+
+		// ------------------------------------------------------------------------
+		/*! Parallel Chunks
+		*
+		*   Splits [first, first + count) in one chunk per thread and runs the
+		*	work over each of them, the last one on the calling thread
+		*/ // ---------------------------------------------------------------------
+		template<typename Work>
+		void ParallelChunks(const std::uint32_t first, const std::uint32_t count, const unsigned threads, Work&& work) {
+			const std::uint32_t chunk = (count + threads - 1) / threads;
+			std::vector<std::thread> workers;
+
+			for (unsigned i = 0; i < threads; i++) {
+				const std::uint32_t begin = first + std::min(count, i * chunk), end = first + std::min(count, (i + 1) * chunk);
+
+				if (i + 1 < threads) workers.emplace_back([&work, i, begin, end]() { work(i, begin, end); });
+				else work(i, begin, end);
+			}
+
+			for (std::thread& worker : workers) worker.join();
+		}
+
+		// ------------------------------------------------------------------------
+		/*! Expand Bits
+		*
+		*   Spreads the lower 10 bits of a number two bits apart, to interleave
+		*	them with those of the other axes
+		*/ // ---------------------------------------------------------------------
+		std::uint32_t ExpandBits(std::uint32_t bits) noexcept {
+			bits = (bits * 0x00010001u) & 0xFF0000FFu;
+			bits = (bits * 0x00000101u) & 0x0F00F00Fu;
+			bits = (bits * 0x00000011u) & 0xC30C30C3u;
+			return (bits * 0x00000005u) & 0x49249249u;
+		}
+	}
+
+	// What the builders share while they split the primitives
+	struct BVH::BuildState {
+		const std::vector<AABB>& bounds;
+		std::vector<glm::vec3> centroids;
+		std::vector<std::uint32_t> codes;
+		std::atomic<std::uint32_t> nodeCount;
+	};
+
+	// ------------------------------------------------------------------------
+	/*! Default Constructor
+	*
+	*   Constructs an empty BVH
+	*/ // ---------------------------------------------------------------------
+	BVH::BVH() noexcept :
+		mBuildTime{ 0.0 } {}
+
+	// ------------------------------------------------------------------------
+	/*! Build
+	*
+	*   Builds the tree over the given primitive boxes, on threadCount threads
+	*	(all of the machine if 0). The SAH builder splits each node where the
+	*	surface area heuristic, estimated over a few bins of centroids, says
+	*	rays will find the fewest primitives. The LBVH one sorts them along a
+	*	Morton curve and splits them where their codes first differ.
+	*	Both split the bins (or codes) of big nodes among the threads, and give
+	*	each child half of them once there are enough nodes to go around
+	*/ // ---------------------------------------------------------------------
+	void BVH::Build(const std::vector<AABB>& bounds, const Builder builder, const unsigned threadCount) {
+		const auto start = std::chrono::steady_clock::now();
+		const unsigned threads = threadCount ? threadCount : std::max(std::thread::hardware_concurrency(), 1u);
+		BuildState state{ bounds, std::vector<glm::vec3>(bounds.size()), {}, { 1 } };
+
+		mNodes.clear();
+		mIndices.resize(bounds.size());
+		std::iota(mIndices.begin(), mIndices.end(), 0u);
+
+		//If there are no primitives, there is no tree
+		if (bounds.empty()) {
+			mBuildTime = 0.0;
+			return;
+		}
+
+		ParallelChunks(0, static_cast<std::uint32_t>(bounds.size()), threads, [&](unsigned, const std::uint32_t begin, const std::uint32_t end) {
+			for (std::uint32_t i = begin; i < end; i++) state.centroids[i] = bounds[i].GetCentroid();
+		});
+
+		// Every split adds two nodes and takes at least a primitive off each side
+		mNodes.resize(bounds.size() * 2 - 1);
+		mNodes[0] = { glm::vec3(0.f), 0, glm::vec3(0.f), static_cast<std::uint32_t>(bounds.size()) };
+
+		if (builder == Builder::LBVH) {
+			SortMorton(state, threads);
+			SubdivideMorton(state, 0, 0, threads);
+		} else Subdivide(state, 0, 0, threads);
+
+		mNodes.resize(state.nodeCount);
+		mNodes.shrink_to_fit();
+		mBuildTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Refit
+	*
+	*   Fits the nodes to new boxes of the same primitives, keeping the tree
+	*	as it is. Children always come after their parent, so going through
+	*	the nodes backwards fits them bottom up in a single pass
+	*/ // ---------------------------------------------------------------------
+	void BVH::Refit(const std::vector<AABB>& bounds) noexcept {
+		for (std::size_t i = mNodes.size(); i--;) {
+			Node& node = mNodes[i];
+			AABB box;
+
+			if (node.count)
+				for (std::uint32_t j = node.leftFirst; j < node.leftFirst + node.count; j++) box.Grow(bounds[mIndices[j]]);
+			else {
+				box = AABB{ mNodes[node.leftFirst].min, mNodes[node.leftFirst].max };
+				box.Grow(AABB{ mNodes[node.leftFirst + 1].min, mNodes[node.leftFirst + 1].max });
+			}
+
+			node.min = box.min;
+			node.max = box.max;
+		}
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Get Cost
+	*
+	*   Returns the SAH cost of the tree, the primitives and nodes a ray
+	*	through the root is expected to test. Refits let it grow, as boxes
+	*	stretch over primitives that moved apart
+	*/ // ---------------------------------------------------------------------
+	float BVH::GetCost() const noexcept {
+		//If there is nothing built, nothing is ever tested
+		if (mNodes.empty()) return 0.f;
+
+		const float rootArea = std::max(AABB{ mNodes[0].min, mNodes[0].max }.GetArea(), FLT_MIN);
+		float cost = 0.f;
+
+		for (const Node& node : mNodes)
+			cost += (node.count ? static_cast<float>(node.count) : cTraversalCost) * AABB{ node.min, node.max }.GetArea();
+
+		return cost / rootArea;
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Subdivide
+	*
+	*   Fits a node to its primitives and splits it in two, unless keeping it
+	*	as a leaf is cheaper (or the tree is already too deep to walk)
+	*/ // ---------------------------------------------------------------------
+	void BVH::Subdivide(BuildState& state, const std::uint32_t node, const std::uint32_t depth, const unsigned threads) {
+		const std::uint32_t first = mNodes[node].leftFirst, count = mNodes[node].count;
+		const unsigned workers = count >= cParallelBinning ? threads : 1;
+		std::vector<AABB> boxes(2 * (workers - 1));
+		AABB box, centroidBox;
+
+		// Threads other than the calling one work on their own boxes, grown into the node ones after
+		ParallelChunks(first, count, workers, [&](const unsigned worker, const std::uint32_t begin, const std::uint32_t end) {
+			AABB& workerBox = worker ? boxes[2 * worker - 2] : box;
+			AABB& workerCentroidBox = worker ? boxes[2 * worker - 1] : centroidBox;
+
+			for (std::uint32_t i = begin; i < end; i++) {
+				workerBox.Grow(state.bounds[mIndices[i]]);
+				workerCentroidBox.Grow(state.centroids[mIndices[i]]);
+			}
+		});
+
+		for (unsigned i = 1; i < workers; i++) {
+			box.Grow(boxes[2 * i - 2]);
+			centroidBox.Grow(boxes[2 * i - 1]);
+		}
+
+		mNodes[node].min = box.min;
+		mNodes[node].max = box.max;
+
+		//If the node is small enough or can't go any deeper, it stays a leaf
+		if (count <= 2 || depth >= cMaxDepth) return;
+
+		const glm::vec3 extent = centroidBox.max - centroidBox.min;
+		const glm::vec3 scale = glm::vec3(static_cast<float>(cBinCount)) / glm::max(extent, glm::vec3(FLT_MIN));
+		Bins bins;
+		std::vector<Bins> workerBins(workers - 1);
+		float bestCost = count * box.GetArea() - cTraversalCost * box.GetArea();
+		int bestAxis = -1, bestSplit = 0;
+
+		// Every thread bins its share of the primitives on every axis, then the bins are added up
+		ParallelChunks(first, count, workers, [&](const unsigned worker, const std::uint32_t begin, const std::uint32_t end) {
+			Bins& mine = worker ? workerBins[worker - 1] : bins;
+
+			for (std::uint32_t i = begin; i < end; i++)
+				for (int axis = 0; axis < 3; axis++) {
+					if (extent[axis] <= 0.f) continue;
+
+					const int bin = std::min(static_cast<int>((state.centroids[mIndices[i]][axis] - centroidBox.min[axis]) * scale[axis]), cBinCount - 1);
+
+					mine[axis][bin].count++;
+					mine[axis][bin].box.Grow(state.bounds[mIndices[i]]);
+				}
+		});
+
+		for (const Bins& other : workerBins)
+			for (int axis = 0; axis < 3; axis++)
+				for (int i = 0; i < cBinCount; i++) {
+					bins[axis][i].count += other[axis][i].count;
+					bins[axis][i].box.Grow(other[axis][i].box);
+				}
+
+		// Try every boundary between bins, on every axis the centroids spread over
+		for (int axis = 0; axis < 3; axis++) {
+			if (extent[axis] <= 0.f) continue;
+
+			const std::array<Bin, cBinCount>& axisBins = bins[axis];
+			float leftArea[cBinCount - 1], leftCount[cBinCount - 1];
+			AABB leftBox, rightBox;
+			std::uint32_t leftSum = 0, rightSum = 0;
+
+			for (int i = 0; i < cBinCount - 1; i++) {
+				leftSum += axisBins[i].count;
+				leftBox.Grow(axisBins[i].box);
+				leftCount[i] = static_cast<float>(leftSum);
+				leftArea[i] = leftBox.GetArea();
+			}
+
+			for (int i = cBinCount - 1; i > 0; i--) {
+				rightSum += axisBins[i].count;
+				rightBox.Grow(axisBins[i].box);
+
+				const float cost = leftCount[i - 1] * leftArea[i - 1] + rightSum * rightBox.GetArea();
+
+				if (cost < bestCost) {
+					bestCost = cost;
+					bestAxis = axis;
+					bestSplit = i;
+				}
+			}
+		}
+
+		//If no split beats intersecting every primitive, the node stays a leaf
+		if (bestAxis < 0) return;
+
+		// Partition the primitives by the side of the split their centroid falls on
+		const auto middle = std::partition(mIndices.begin() + first, mIndices.begin() + first + count, [&](const std::uint32_t index) {
+			return std::min(static_cast<int>((state.centroids[index][bestAxis] - centroidBox.min[bestAxis]) * scale[bestAxis]), cBinCount - 1) < bestSplit;
+		});
+		const std::uint32_t leftCount = static_cast<std::uint32_t>(middle - mIndices.begin()) - first;
+
+		//If rounding left a side empty, there is nothing to split
+		if (!leftCount || leftCount == count) return;
+
+		const std::uint32_t left = state.nodeCount.fetch_add(2);
+
+		mNodes[left] = { glm::vec3(0.f), first, glm::vec3(0.f), leftCount };
+		mNodes[left + 1] = { glm::vec3(0.f), first + leftCount, glm::vec3(0.f), count - leftCount };
+		mNodes[node].leftFirst = left;
+		mNodes[node].count = 0;
+
+		//If there are threads to spare, the children are built at the same time, sharing them
+		if (threads > 1 && count >= cParallelTask) {
+			std::thread leftTask([&]() { Subdivide(state, left, depth + 1, threads / 2); });
+
+			Subdivide(state, left + 1, depth + 1, threads - threads / 2);
+			leftTask.join();
+		} else {
+			Subdivide(state, left, depth + 1, 1);
+			Subdivide(state, left + 1, depth + 1, 1);
+		}
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Sort Morton
+	*
+	*   Sorts the primitives along a Morton curve through the box of their
+	*	centroids, each thread sorting a share of them before they are merged
+	*/ // ---------------------------------------------------------------------
+	void BVH::SortMorton(BuildState& state, const unsigned threads) {
+		const std::uint32_t count = static_cast<std::uint32_t>(mIndices.size());
+		const std::uint32_t chunk = (count + threads - 1) / threads;
+		std::vector<std::uint64_t> keys(count);
+		AABB centroidBox;
+
+		for (const glm::vec3& centroid : state.centroids) centroidBox.Grow(centroid);
+
+		const glm::vec3 scale = glm::vec3(1023.f) / glm::max(centroidBox.max - centroidBox.min, glm::vec3(FLT_MIN));
+
+		// Keys carry the code above the index, so sorting them sorts both
+		ParallelChunks(0, count, threads, [&](unsigned, const std::uint32_t begin, const std::uint32_t end) {
+			for (std::uint32_t i = begin; i < end; i++) {
+				const glm::uvec3 cell = glm::uvec3(glm::clamp((state.centroids[i] - centroidBox.min) * scale, glm::vec3(0.f), glm::vec3(1023.f)));
+				const std::uint32_t code = (ExpandBits(cell.x) << 2) | (ExpandBits(cell.y) << 1) | ExpandBits(cell.z);
+
+				keys[i] = (static_cast<std::uint64_t>(code) << 32) | i;
+			}
+
+			std::sort(keys.begin() + begin, keys.begin() + end);
+		});
+
+		for (std::uint32_t width = chunk; width < count; width *= 2)
+			for (std::uint32_t begin = 0; begin + width < count; begin += 2 * width)
+				std::inplace_merge(keys.begin() + begin, keys.begin() + begin + width, keys.begin() + std::min(begin + 2 * width, count));
+
+		state.codes.resize(count);
+
+		for (std::uint32_t i = 0; i < count; i++) {
+			mIndices[i] = static_cast<std::uint32_t>(keys[i]);
+			state.codes[i] = static_cast<std::uint32_t>(keys[i] >> 32);
+		}
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Subdivide Morton
+	*
+	*   Splits a node of sorted primitives at the highest bit their codes
+	*	differ in (or in half, if they share it), and fits it to its children
+	*	once they are built
+	*/ // ---------------------------------------------------------------------
+	void BVH::SubdivideMorton(BuildState& state, const std::uint32_t node, const std::uint32_t depth, const unsigned threads) {
+		const std::uint32_t first = mNodes[node].leftFirst, count = mNodes[node].count;
+
+		//If the node is small enough or can't go any deeper, it stays a leaf
+		if (count <= 2 || depth >= cMaxDepth) {
+			AABB box;
+
+			for (std::uint32_t i = first; i < first + count; i++) box.Grow(state.bounds[mIndices[i]]);
+
+			mNodes[node].min = box.min;
+			mNodes[node].max = box.max;
+			return;
+		}
+
+		const std::uint32_t firstCode = state.codes[first], lastCode = state.codes[first + count - 1];
+		std::uint32_t leftCount = count / 2;
+
+		// Codes below the first one with the highest differing bit set go to the left
+		if (firstCode != lastCode) {
+			std::uint32_t difference = firstCode ^ lastCode;
+
+			for (int shift = 1; shift < 32; shift *= 2) difference |= difference >> shift;
+
+			const std::uint32_t splitCode = lastCode & ~(difference >> 1);
+
+			leftCount = static_cast<std::uint32_t>(std::lower_bound(state.codes.begin() + first, state.codes.begin() + first + count, splitCode) -
+				state.codes.begin()) - first;
+		}
+
+		const std::uint32_t left = state.nodeCount.fetch_add(2);
+
+		mNodes[left] = { glm::vec3(0.f), first, glm::vec3(0.f), leftCount };
+		mNodes[left + 1] = { glm::vec3(0.f), first + leftCount, glm::vec3(0.f), count - leftCount };
+
+		if (threads > 1 && count >= cParallelTask) {
+			std::thread leftTask([&]() { SubdivideMorton(state, left, depth + 1, threads / 2); });
+
+			SubdivideMorton(state, left + 1, depth + 1, threads - threads / 2);
+			leftTask.join();
+		} else {
+			SubdivideMorton(state, left, depth + 1, 1);
+			SubdivideMorton(state, left + 1, depth + 1, 1);
+		}
+
+		AABB box{ mNodes[left].min, mNodes[left].max };
+
+		box.Grow(AABB{ mNodes[left + 1].min, mNodes[left + 1].max });
+		mNodes[node].min = box.min;
+		mNodes[node].max = box.max;
+		mNodes[node].leftFirst = left;
+		mNodes[node].count = 0;
+	}
+}
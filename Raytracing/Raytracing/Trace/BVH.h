@@ -0,0 +1,258 @@
+//
+//	BVH.h
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 25/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#ifndef _BVH__H_
+#define _BVH__H_
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include "../CommonDefines.h"
+
+namespace Trace {
+	// Axis aligned box, in single precision like the nodes that store it
+	struct AABB {
+		glm::vec3 min{ FLT_MAX }, max{ -FLT_MAX };
+
+		inline void Grow(const glm::vec3& point) noexcept;
+		inline void Grow(const AABB& box) noexcept;
+		DONTDISCARD inline glm::vec3 GetCentroid() const noexcept;
+		DONTDISCARD inline float GetArea() const noexcept;
+	};
+
+	class BVH {
+#pragma region //Declarations
+	public:
+		// Inner nodes point to the first of their two consecutive children, leaves
+		// (count > 0) to the first of their primitives in the index list
+		struct Node {
+			glm::vec3 min;
+			std::uint32_t leftFirst;
+			glm::vec3 max;
+			std::uint32_t count;
+		};
+
+		// SAH trees are slower to build but faster to walk. LBVH ones just split
+		// the primitives along a Morton curve, for things rebuilt every frame
+		enum class Builder {
+			SAH,
+			LBVH
+		};
+	private:
+		struct BuildState;
+#pragma endregion
+
+#pragma region //Constructors & Destructors
+	public:
+		BVH() noexcept;
+#pragma endregion
+
+#pragma region //Methods
+		void Build(const std::vector<AABB>& bounds, const Builder builder = Builder::SAH, const unsigned threadCount = 0);
+		void Refit(const std::vector<AABB>& bounds) noexcept;
+		DONTDISCARD float GetCost() const noexcept;
+		template<bool AnyHit = false, typename Test>
+		DONTDISCARD inline bool Intersect(const glm::dvec3& origin, const glm::dvec3& direction, double& tMax, Test&& test) const noexcept;
+		DONTDISCARD inline const std::vector<Node>& GetNodes() const noexcept;
+		DONTDISCARD inline const std::vector<std::uint32_t>& GetIndices() const noexcept;
+		DONTDISCARD inline AABB GetBounds() const noexcept;
+		DONTDISCARD inline double GetBuildTime() const noexcept;
+		DONTDISCARD static inline glm::vec3 GetInverse(const glm::dvec3& direction) noexcept;
+		DONTDISCARD static inline float GetLimit(const double tMax) noexcept;
+	private:
+		void Subdivide(BuildState& state, const std::uint32_t node, const std::uint32_t depth, const unsigned threads);
+		void SubdivideMorton(BuildState& state, const std::uint32_t node, const std::uint32_t depth, const unsigned threads);
+		void SortMorton(BuildState& state, const unsigned threads);
+		DONTDISCARD static inline float IntersectNode(const Node& node, const glm::vec3& origin, const glm::vec3& inverse, const float tMax) noexcept;
+#pragma endregion
+
+#pragma region //Members
+		std::vector<Node> mNodes;
+		std::vector<std::uint32_t> mIndices;
+		double mBuildTime;
+#pragma endregion
+	};
+
+	// ------------------------------------------------------------------------
+	/*! Grow
+	*
+	*   Grows the box to contain a point
+	*/ // ---------------------------------------------------------------------
+	void AABB::Grow(const glm::vec3& point) noexcept {
+		min = glm::min(min, point);
+		max = glm::max(max, point);
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Grow
+	*
+	*   Grows the box to contain another box
+	*/ // ---------------------------------------------------------------------
+	void AABB::Grow(const AABB& box) noexcept {
+		min = glm::min(min, box.min);
+		max = glm::max(max, box.max);
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Get Centroid
+	*
+	*   Returns the center of the box
+	*/ // ---------------------------------------------------------------------
+	glm::vec3 AABB::GetCentroid() const noexcept {
+		return (min + max) * 0.5f;
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Get Area
+	*
+	*   Returns the half surface area of the box, all the SAH needs. Empty
+	*	boxes have none
+	*/ // ---------------------------------------------------------------------
+	float AABB::GetArea() const noexcept {
+		const glm::vec3 extent = glm::max(max - min, glm::vec3(0.f));
+
+		return (extent.x * extent.y) + (extent.y * extent.z) + (extent.z * extent.x);
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Intersect
+	*
+	*   Walks the nodes the ray goes through, nearest child first, calling the
+	*	test with each primitive index in the leaves reached. The test returns
+	*	whether the primitive was hit, shortening tMax to the hit if so.
+	*	Subtrees beyond the closest hit so far are skipped. AnyHit walks stop at
+	*	the first hit instead, which is all occlusion needs to know
+	*/ // ---------------------------------------------------------------------
+	template<bool AnyHit, typename Test>
+	bool BVH::Intersect(const glm::dvec3& origin, const glm::dvec3& direction, double& tMax, Test&& test) const noexcept {
+		//If there is nothing built, there is nothing to hit
+		if (mNodes.empty()) return false;
+
+		const glm::vec3 rayOrigin(origin);
+		const glm::vec3 inverse = GetInverse(direction);
+		std::uint32_t stack[64], stackSize = 0, current = 0;
+		bool hit = false;
+
+		//If the ray misses the whole tree, there is nothing to walk
+		if (IntersectNode(mNodes[0], rayOrigin, inverse, GetLimit(tMax)) == FLT_MAX) return false;
+
+		for (;;) {
+			const Node& node = mNodes[current];
+
+			if (node.count) {
+				for (std::uint32_t i = 0; i < node.count; i++)
+					if (test(mIndices[node.leftFirst + i], tMax)) {
+						if constexpr (AnyHit) return true;
+						hit = true;
+					}
+			} else {
+				std::uint32_t closest = node.leftFirst, farthest = node.leftFirst + 1;
+				float tClosest = IntersectNode(mNodes[closest], rayOrigin, inverse, GetLimit(tMax));
+				float tFarthest = IntersectNode(mNodes[farthest], rayOrigin, inverse, GetLimit(tMax));
+
+				if (tClosest > tFarthest) {
+					std::swap(closest, farthest);
+					std::swap(tClosest, tFarthest);
+				}
+
+				// Go down the nearest child, keeping the other one for later
+				if (tClosest != FLT_MAX) {
+					if (tFarthest != FLT_MAX) stack[stackSize++] = farthest;
+					current = closest;
+					continue;
+				}
+			}
+
+			if (!stackSize) return hit;
+			current = stack[--stackSize];
+		}
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Get Inverse
+	*
+	*   Returns the inverse of a ray direction for the slab tests. Axes the ray
+	*	runs parallel to get a huge (not infinite) value, so rays starting right
+	*	on a slab don't turn into NaNs
+	*/ // ---------------------------------------------------------------------
+	glm::vec3 BVH::GetInverse(const glm::dvec3& direction) noexcept {
+		glm::vec3 inverse;
+
+		for (int i = 0; i < 3; i++)
+			inverse[i] = static_cast<float>(direction[i]) != 0.f ? 1.f / static_cast<float>(direction[i]) : std::copysign(FLT_MAX, static_cast<float>(direction[i]));
+
+		return inverse;
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Get Limit
+	*
+	*   Returns tMax in single precision for the slab tests. Unbounded rays
+	*	(like those starting at the largest double) are clamped to FLT_MAX, as
+	*	converting what a float can't hold is undefined
+	*/ // ---------------------------------------------------------------------
+	float BVH::GetLimit(const double tMax) noexcept {
+		return static_cast<float>(std::min(tMax, static_cast<double>(FLT_MAX)));
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Intersect Node
+	*
+	*   Returns the distance at which a ray enters a node (slab test), or
+	*	FLT_MAX if it misses it or only gets there past tMax
+	*/ // ---------------------------------------------------------------------
+	float BVH::IntersectNode(const Node& node, const glm::vec3& origin, const glm::vec3& inverse, const float tMax) noexcept {
+		const glm::vec3 t1 = (node.min - origin) * inverse;
+		const glm::vec3 t2 = (node.max - origin) * inverse;
+		const float tEnter = std::max({ std::min(t1.x, t2.x), std::min(t1.y, t2.y), std::min(t1.z, t2.z), 0.f });
+		const float tExit = std::min({ std::max(t1.x, t2.x), std::max(t1.y, t2.y), std::max(t1.z, t2.z), tMax });
+
+		return tEnter <= tExit ? tEnter : FLT_MAX;
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Get Nodes
+	*
+	*   Returns the nodes of the tree, the root being the first one
+	*/ // ---------------------------------------------------------------------
+	const std::vector<BVH::Node>& BVH::GetNodes() const noexcept {
+		return mNodes;
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Get Indices
+	*
+	*   Returns the primitive indices, in the order the leaves refer to them
+	*/ // ---------------------------------------------------------------------
+	const std::vector<std::uint32_t>& BVH::GetIndices() const noexcept {
+		return mIndices;
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Get Bounds
+	*
+	*   Returns the box around every primitive in the tree
+	*/ // ---------------------------------------------------------------------
+	AABB BVH::GetBounds() const noexcept {
+		return mNodes.empty() ? AABB{} : AABB{ mNodes[0].min, mNodes[0].max };
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Get Build Time
+	*
+	*   Returns how long the last Build took, in milliseconds
+	*/ // ---------------------------------------------------------------------
+	double BVH::GetBuildTime() const noexcept {
+		return mBuildTime;
+	}
+}
+
+#endif
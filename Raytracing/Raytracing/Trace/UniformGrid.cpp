@@ -0,0 +1,90 @@
+//
+//	UniformGrid.cpp
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 31/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#include "UniformGrid.h"
+#include <chrono>
+
+namespace Trace {
+	namespace {
+		// Cap on the cells along an axis, so sparse scenes don't blow up the grid
+		constexpr int cMaxResolution = 512;
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Default Constructor
+	*
+	*   Constructs an empty Uniform Grid
+	*/ // ---------------------------------------------------------------------
+	UniformGrid::UniformGrid() noexcept :
+		mResolution{ 1 }, mCellSize{ 1.f }, mBuildTime{ 0.0 } {}
+
+	// ------------------------------------------------------------------------
+	/*! Build
+	*
+	*   Builds the grid over the boxes of the primitives, with about density
+	*	cells per primitive, shaped as close to cubes as the box around them
+	*	allows. The cell lists are filled in two passes (count, then place)
+	*	over the cells each box overlaps, linear in the primitives
+	*/ // ---------------------------------------------------------------------
+	void UniformGrid::Build(const std::vector<AABB>& bounds, const float density) {
+		const auto start = std::chrono::steady_clock::now();
+
+		mBounds = AABB{};
+		mCellStart.clear();
+		mIndices.clear();
+
+		//If there are no primitives, there is no grid
+		if (bounds.empty()) {
+			mBuildTime = 0.0;
+			return;
+		}
+
+		for (const AABB& box : bounds) mBounds.Grow(box);
+
+		// Flat scenes still get some thickness, for the cells to have a volume
+		const glm::vec3 extent = glm::max(mBounds.max - mBounds.min, glm::vec3(glm::max(mBounds.max.x - mBounds.min.x,
+			glm::max(mBounds.max.y - mBounds.min.y, mBounds.max.z - mBounds.min.z)) * 1e-3f + 1e-6f));
+		const float cellsPerUnit = std::cbrt(density * bounds.size() / (extent.x * extent.y * extent.z));
+
+		mBounds.max = mBounds.min + extent;
+		mResolution = glm::clamp(glm::ivec3(extent * cellsPerUnit), glm::ivec3(1), glm::ivec3(cMaxResolution));
+		mCellSize = extent / glm::vec3(mResolution);
+
+		const std::size_t cellCount = static_cast<std::size_t>(mResolution.x) * mResolution.y * mResolution.z;
+		std::vector<glm::ivec3> first(bounds.size()), last(bounds.size());
+
+		mCellStart.assign(cellCount + 1, 0);
+
+		// Count how many primitives overlap every cell...
+		for (std::size_t i = 0; i < bounds.size(); i++) {
+			first[i] = GetCell(bounds[i].min);
+			last[i] = GetCell(bounds[i].max);
+
+			for (int z = first[i].z; z <= last[i].z; z++)
+				for (int y = first[i].y; y <= last[i].y; y++)
+					for (int x = first[i].x; x <= last[i].x; x++)
+						mCellStart[(static_cast<std::size_t>(z) * mResolution.y + y) * mResolution.x + x + 1]++;
+		}
+
+		// ...so each of them knows where its list starts...
+		for (std::size_t i = 0; i < cellCount; i++) mCellStart[i + 1] += mCellStart[i];
+
+		std::vector<std::uint32_t> fill(mCellStart.begin(), mCellStart.end() - 1);
+
+		mIndices.resize(mCellStart.back());
+
+		// ...and place them
+		for (std::size_t i = 0; i < bounds.size(); i++)
+			for (int z = first[i].z; z <= last[i].z; z++)
+				for (int y = first[i].y; y <= last[i].y; y++)
+					for (int x = first[i].x; x <= last[i].x; x++)
+						mIndices[fill[(static_cast<std::size_t>(z) * mResolution.y + y) * mResolution.x + x]++] = static_cast<std::uint32_t>(i);
+
+		mBuildTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+}
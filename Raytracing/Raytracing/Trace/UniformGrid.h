@@ -0,0 +1,146 @@
+//
+//	UniformGrid.h
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 31/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#ifndef _UNIFORM_GRID__H_
+#define _UNIFORM_GRID__H_
+
+#include "BVH.h"
+
+namespace Trace {
+	// Grid of equally sized cells over the primitives, each listing those whose
+	// boxes overlap it. It is built in linear time, far faster than any tree,
+	// and suits many primitives of about the same size spread over the scene
+	class UniformGrid {
+#pragma region //Constructors & Destructors
+	public:
+		UniformGrid() noexcept;
+#pragma endregion
+
+#pragma region //Methods
+		void Build(const std::vector<AABB>& bounds, const float density = 8.f);
+		template<bool AnyHit = false, typename Test>
+		DONTDISCARD inline bool Intersect(const glm::dvec3& origin, const glm::dvec3& direction, double& tMax, Test&& test) const noexcept;
+		DONTDISCARD inline AABB GetBounds() const noexcept;
+		DONTDISCARD inline glm::ivec3 GetResolution() const noexcept;
+		DONTDISCARD inline double GetBuildTime() const noexcept;
+	private:
+		DONTDISCARD inline glm::ivec3 GetCell(const glm::vec3& point) const noexcept;
+#pragma endregion
+
+#pragma region //Members
+		AABB mBounds;
+		glm::ivec3 mResolution;
+		glm::vec3 mCellSize;
+		std::vector<std::uint32_t> mCellStart;
+		std::vector<std::uint32_t> mIndices;
+		double mBuildTime;
+#pragma endregion
+	};
+
+	// ------------------------------------------------------------------------
+	/*! Intersect
+	*
+	*   Walks the cells the ray goes through in order (3D-DDA), calling the
+	*	test with each primitive index listed in them. The test returns
+	*	whether the primitive was hit, shortening tMax to the hit if so.
+	*	Primitives spanning several cells may be tested more than once. The
+	*	walk stops at the first cell a hit so far lies within, as no later
+	*	one can hold a closer hit, or at the first hit for AnyHit walks
+	*/ // ---------------------------------------------------------------------
+	template<bool AnyHit, typename Test>
+	bool UniformGrid::Intersect(const glm::dvec3& origin, const glm::dvec3& direction, double& tMax, Test&& test) const noexcept {
+		//If there is nothing built, there is nothing to hit
+		if (mIndices.empty()) return false;
+
+		double tEnter = 0.0, tExit = tMax;
+
+		for (int i = 0; i < 3; i++) {
+			const double inverse = direction[i] != 0.0 ? 1.0 / direction[i] : std::copysign(DBL_MAX, direction[i]);
+			const double t1 = (mBounds.min[i] - origin[i]) * inverse, t2 = (mBounds.max[i] - origin[i]) * inverse;
+
+			tEnter = std::max(tEnter, std::min(t1, t2));
+			tExit = std::min(tExit, std::max(t1, t2));
+		}
+
+		//If the ray misses the grid, there are no cells to walk
+		if (tEnter > tExit) return false;
+
+		glm::ivec3 cell = GetCell(glm::vec3(origin + direction * tEnter)), step;
+		glm::dvec3 tNext, tDelta;
+		bool hit = false;
+
+		for (int i = 0; i < 3; i++) {
+			// Axes the ray runs parallel to never get to the next cell
+			if (direction[i] == 0.0) {
+				step[i] = 0;
+				tNext[i] = tDelta[i] = DBL_MAX;
+				continue;
+			}
+
+			step[i] = direction[i] > 0.0 ? 1 : -1;
+			tDelta[i] = mCellSize[i] / std::abs(direction[i]);
+			tNext[i] = (mBounds.min[i] + static_cast<double>(mCellSize[i]) * (cell[i] + (step[i] > 0)) - origin[i]) / direction[i];
+		}
+
+		for (;;) {
+			const std::size_t index = (static_cast<std::size_t>(cell.z) * mResolution.y + cell.y) * mResolution.x + cell.x;
+			const int axis = tNext.x < tNext.y ? (tNext.x < tNext.z ? 0 : 2) : (tNext.y < tNext.z ? 1 : 2);
+
+			for (std::uint32_t i = mCellStart[index]; i < mCellStart[index + 1]; i++)
+				if (test(mIndices[i], tMax)) {
+					if constexpr (AnyHit) return true;
+					hit = true;
+				}
+
+			//If the closest hit so far is within this cell, or the ray leaves the grid, we are done
+			if (tMax <= tNext[axis] || tNext[axis] > tExit) return hit;
+
+			cell[axis] += step[axis];
+			if (cell[axis] < 0 || cell[axis] >= mResolution[axis]) return hit;
+			tNext[axis] += tDelta[axis];
+		}
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Get Bounds
+	*
+	*   Returns the box the grid spans, around every primitive in it
+	*/ // ---------------------------------------------------------------------
+	AABB UniformGrid::GetBounds() const noexcept {
+		return mBounds;
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Get Resolution
+	*
+	*   Returns how many cells the grid has along each axis
+	*/ // ---------------------------------------------------------------------
+	glm::ivec3 UniformGrid::GetResolution() const noexcept {
+		return mResolution;
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Get Build Time
+	*
+	*   Returns how long the last Build took, in milliseconds
+	*/ // ---------------------------------------------------------------------
+	double UniformGrid::GetBuildTime() const noexcept {
+		return mBuildTime;
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Get Cell
+	*
+	*   Returns the cell a point falls in, clamped to the grid
+	*/ // ---------------------------------------------------------------------
+	glm::ivec3 UniformGrid::GetCell(const glm::vec3& point) const noexcept {
+		return glm::clamp(glm::ivec3((point - mBounds.min) / mCellSize), glm::ivec3(0), mResolution - 1);
+	}
+}
+
+#endif
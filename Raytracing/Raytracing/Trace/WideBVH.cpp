@@ -0,0 +1,332 @@
+//
+//	WideBVH.cpp
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 27/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#include "WideBVH.h"
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <thread>
+#include "../Core/MappedFile.h"
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace Trace {
+	namespace {
+		// Scales need a normal float, which a plain exponent byte can hold
+		constexpr int cMinExponent = -126;
+		constexpr int cMaxExponent = 127;
+
+		constexpr char cMagic[4] = { 'S', 'R', 'B', 'V' };
+		constexpr std::uint32_t cVersion = 1;
+		constexpr std::size_t cHeaderSize = 64;
+
+		// Fixed size header in front of the nodes, padded to cHeaderSize bytes so they
+		// stay aligned to a cache line. The indices follow the nodes
+		struct CacheHeader {
+			char magic[4];
+			std::uint32_t version;
+			std::uint64_t key;
+			std::uint32_t nodeSize;
+			std::uint32_t nodeCount;
+			std::uint32_t indexCount;
+			glm::vec3 min, max;
+		};
+
+		static_assert(sizeof(CacheHeader) <= cHeaderSize, "BVH cache header does not fit");
+		static_assert(cHeaderSize % alignof(WideBVH::Node) == 0, "BVH cache nodes would be misaligned");
+
+		// ------------------------------------------------------------------------
+		/*! Get Temporary Path
+		*
+		*   Returns the name a tree is written under before it is renamed into
+		*	place. No other writer uses it at the same time: processes differ in
+		*	their id, and threads within one in theirs
+		*/ // ---------------------------------------------------------------------
+		std::string GetTemporaryPath(const std::string& path) {
+#ifdef _WIN32
+			const long process = static_cast<long>(_getpid());
+#else
+			const long process = static_cast<long>(getpid());
+#endif
+			char suffix[64];
+
+			std::snprintf(suffix, sizeof(suffix), ".%ld.%zx.tmp", process, std::hash<std::thread::id>{}(std::this_thread::get_id()));
+			return path + suffix;
+		}
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Default Constructor
+	*
+	*   Constructs an empty Wide BVH
+	*/ // ---------------------------------------------------------------------
+	WideBVH::WideBVH() noexcept :
+		mNodes{ nullptr }, mIndices{ nullptr }, mNodeCount{ 0 }, mIndexCount{ 0 } {}
+
+	// ------------------------------------------------------------------------
+	/*! Build
+	*
+	*   Builds the tree by collapsing a binary one, pulling the grandchildren
+	*	of every node up into it until it has four children. The primitives
+	*	keep the order the binary leaves give them
+	*/ // ---------------------------------------------------------------------
+	void WideBVH::Build(const BVH& bvh) {
+		const std::shared_ptr<Storage> storage = std::make_shared<Storage>();
+
+		storage->indices = bvh.GetIndices();
+
+		//If there are primitives, there is a tree over them
+		if (!bvh.GetNodes().empty()) {
+			storage->nodes.reserve(bvh.GetNodes().size() / 2 + 1);
+			Collapse(storage->nodes, bvh, 0);
+			storage->nodes.shrink_to_fit();
+		}
+
+		mNodes = storage->nodes.data();
+		mNodeCount = static_cast<std::uint32_t>(storage->nodes.size());
+		mIndices = storage->indices.data();
+		mIndexCount = static_cast<std::uint32_t>(storage->indices.size());
+		mBounds = bvh.GetBounds();
+		mData = storage;
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Save
+	*
+	*   Writes the tree to a file, laid out as it is in memory so Load can
+	*	map it as is. The key tells what it was built from. The file is
+	*	written under a name of its own and then renamed, so other processes
+	*	never map a half written one, nor write over the same one
+	*/ // ---------------------------------------------------------------------
+	void WideBVH::Save(const std::string& path, const std::uint64_t key) const {
+		const std::string temporary = GetTemporaryPath(path);
+		char header[cHeaderSize] = {};
+		CacheHeader info{ {}, cVersion, key, static_cast<std::uint32_t>(sizeof(Node)), mNodeCount, mIndexCount, mBounds.min, mBounds.max };
+
+		std::memcpy(info.magic, cMagic, sizeof(cMagic));
+		std::memcpy(header, &info, sizeof(info));
+
+		{
+			std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+
+			file.write(header, sizeof(header));
+			file.write(reinterpret_cast<const char*>(mNodes), static_cast<std::streamsize>(mNodeCount * sizeof(Node)));
+			file.write(reinterpret_cast<const char*>(mIndices), static_cast<std::streamsize>(mIndexCount * sizeof(std::uint32_t)));
+
+			//If the tree didn't make it to disk, it must not be loaded later
+			if (!file) {
+				file.close();
+				std::remove(temporary.c_str());
+				throw WideBVHException("Failed to write BVH cache");
+			}
+		}
+
+		// Another process may have stored the same tree first, which is just as good
+		std::remove(path.c_str());
+		if (std::rename(temporary.c_str(), path.c_str())) std::remove(temporary.c_str());
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Load
+	*
+	*   Maps a tree saved with the given key, over primitiveCount primitives,
+	*	using its nodes and indices right where they are in the file. Returns
+	*	false, leaving the tree as it was, if there is no such file or it
+	*	doesn't hold a matching, well formed tree
+	*/ // ---------------------------------------------------------------------
+	bool WideBVH::Load(const std::string& path, const std::uint64_t key, const std::uint32_t primitiveCount) {
+		std::shared_ptr<const Core::MappedFile> file;
+		CacheHeader info;
+
+		try {
+			file = std::make_shared<const Core::MappedFile>(path);
+		} catch (const Core::MappedFile::MappedFileException&) {
+			return false;
+		}
+
+		//If the file is too short for a header, it holds no tree
+		if (file->GetSize() < cHeaderSize) return false;
+
+		std::memcpy(&info, file->GetData(), sizeof(info));
+
+		//If the tree was built from something else, or laid out by another version, it is of no use
+		if (std::memcmp(info.magic, cMagic, sizeof(cMagic)) || info.version != cVersion || info.key != key || info.nodeSize != sizeof(Node) ||
+			file->GetSize() != cHeaderSize + std::size_t(info.nodeCount) * sizeof(Node) + std::size_t(info.indexCount) * sizeof(std::uint32_t))
+			return false;
+
+		const char* data = static_cast<const char*>(file->GetData());
+		WideBVH loaded;
+
+		loaded.mNodes = reinterpret_cast<const Node*>(data + cHeaderSize);
+		loaded.mNodeCount = info.nodeCount;
+		loaded.mIndices = reinterpret_cast<const std::uint32_t*>(data + cHeaderSize + std::size_t(info.nodeCount) * sizeof(Node));
+		loaded.mIndexCount = info.indexCount;
+		loaded.mBounds = AABB{ info.min, info.max };
+		loaded.mData = file;
+
+		//If the file was damaged, walking it could go anywhere
+		if (!loaded.IsValid(primitiveCount)) return false;
+
+		*this = std::move(loaded);
+		return true;
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Is Valid
+	*
+	*   Returns whether every child points inside the tree, every leaf inside
+	*	the indices and every index to one of the primitives. Inner children
+	*	must come after their parent, as Build lays them out, so no walk loops
+	*/ // ---------------------------------------------------------------------
+	bool WideBVH::IsValid(const std::uint32_t primitiveCount) const noexcept {
+		for (std::uint32_t i = 0; i < mIndexCount; i++)
+			if (mIndices[i] >= primitiveCount) return false;
+
+		for (std::uint32_t n = 0; n < mNodeCount; n++) {
+			const Node& node = mNodes[n];
+
+			if (node.childCount > cWidth) return false;
+
+			for (std::uint32_t i = 0; i < node.childCount; i++)
+				if (node.count[i] ? std::uint64_t(node.child[i]) + node.count[i] > mIndexCount :
+					node.child[i] <= n || node.child[i] >= mNodeCount) return false;
+		}
+
+		return true;
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Collapse
+	*
+	*   Adds the node standing for a binary subtree, opening up its largest
+	*	inner nodes (those most rays go into) while there are slots left.
+	*	Returns the index of the new node
+	*/ // ---------------------------------------------------------------------
+	std::uint32_t WideBVH::Collapse(std::vector<Node>& nodes, const BVH& bvh, const std::uint32_t node) {
+		const std::vector<BVH::Node>& binary = bvh.GetNodes();
+		std::uint32_t children[cWidth] = { node }, childCount = 1;
+		AABB boxes[cWidth];
+
+		while (childCount < cWidth) {
+			int largest = -1;
+			float largestArea = -1.f;
+
+			for (std::uint32_t i = 0; i < childCount; i++) {
+				const BVH::Node& child = binary[children[i]];
+				const float area = AABB{ child.min, child.max }.GetArea();
+
+				if (!child.count && area > largestArea) {
+					largest = static_cast<int>(i);
+					largestArea = area;
+				}
+			}
+
+			//If every child is a leaf, there is nothing left to open
+			if (largest < 0) break;
+
+			children[childCount++] = binary[children[largest]].leftFirst + 1;
+			children[largest] = binary[children[largest]].leftFirst;
+		}
+
+		for (std::uint32_t i = 0; i < childCount; i++)
+			boxes[i] = AABB{ binary[children[i]].min, binary[children[i]].max };
+
+		const std::uint32_t index = AddNode(nodes, boxes, childCount);
+
+		// Children are added after their parent, so the parent is only reached through its index
+		for (std::uint32_t i = 0; i < childCount; i++) {
+			const BVH::Node& child = binary[children[i]];
+			std::uint32_t target = child.leftFirst, count = child.count;
+
+			if (!count) target = Collapse(nodes, bvh, children[i]);
+			else if (count > cMaxLeafSize) {
+				target = SplitLeaf(nodes, child.leftFirst, count, boxes[i]);
+				count = 0;
+			}
+
+			nodes[index].child[i] = target;
+			nodes[index].count[i] = static_cast<std::uint8_t>(count);
+		}
+
+		return index;
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Split Leaf
+	*
+	*   Adds a node over a leaf too big for a count byte, spreading its
+	*	primitives among up to four smaller leaves. Returns its index
+	*/ // ---------------------------------------------------------------------
+	std::uint32_t WideBVH::SplitLeaf(std::vector<Node>& nodes, const std::uint32_t first, const std::uint32_t count, const AABB& box) {
+		const std::uint32_t chunk = (count + cWidth - 1) / cWidth;
+		const std::uint32_t childCount = (count + chunk - 1) / chunk;
+		const AABB boxes[cWidth] = { box, box, box, box };
+		const std::uint32_t index = AddNode(nodes, boxes, childCount);
+
+		for (std::uint32_t i = 0; i < childCount; i++) {
+			const std::uint32_t start = first + i * chunk, size = std::min(chunk, first + count - start);
+			const bool fits = size <= cMaxLeafSize;
+			const std::uint32_t target = fits ? start : SplitLeaf(nodes, start, size, box);
+
+			nodes[index].child[i] = target;
+			nodes[index].count[i] = static_cast<std::uint8_t>(fits ? size : 0);
+		}
+
+		return index;
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Add Node
+	*
+	*   Adds a node with the given child boxes, quantized against the box
+	*	around them all. The planes are rounded outwards, and the scale grown
+	*	until the last step reaches the far corner, so the stored boxes always
+	*	contain the real ones
+	*/ // ---------------------------------------------------------------------
+	std::uint32_t WideBVH::AddNode(std::vector<Node>& nodes, const AABB* boxes, const std::uint32_t childCount) {
+		Node node{};
+		AABB box;
+
+		for (std::uint32_t i = 0; i < childCount; i++) box.Grow(boxes[i]);
+
+		node.origin = box.min;
+		node.childCount = static_cast<std::uint8_t>(childCount);
+
+		for (int axis = 0; axis < 3; axis++) {
+			int exponent;
+
+			std::frexp((box.max[axis] - box.min[axis]) / 255.f, &exponent);
+			exponent = std::max(exponent, cMinExponent);
+
+			while (exponent < cMaxExponent && box.min[axis] + 255.f * std::ldexp(1.f, exponent) < box.max[axis]) exponent++;
+
+			const float scale = std::ldexp(1.f, exponent);
+
+			node.exponent[axis] = static_cast<std::int8_t>(exponent);
+
+			for (std::uint32_t i = 0; i < childCount; i++) {
+				int low = std::clamp(static_cast<int>(std::floor((boxes[i].min[axis] - box.min[axis]) / scale)), 0, 255);
+				int high = std::clamp(static_cast<int>(std::ceil((boxes[i].max[axis] - box.min[axis]) / scale)), 0, 255);
+
+				// Undo any rounding on the way in, checking against the positions traversal will see
+				while (low > 0 && box.min[axis] + static_cast<float>(low) * scale > boxes[i].min[axis]) low--;
+				while (high < 255 && box.min[axis] + static_cast<float>(high) * scale < boxes[i].max[axis]) high++;
+
+				node.min[axis][i] = static_cast<std::uint8_t>(low);
+				node.max[axis][i] = static_cast<std::uint8_t>(high);
+			}
+		}
+
+		nodes.push_back(node);
+		return static_cast<std::uint32_t>(nodes.size() - 1);
+	}
+}
@@ -0,0 +1,226 @@
+//
+//	WideBVH.h
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 27/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#ifndef _WIDE_BVH__H_
+#define _WIDE_BVH__H_
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <emmintrin.h>
+#include "BVH.h"
+
+namespace Trace {
+	class WideBVH {
+#pragma region //Declarations
+	public:
+		CLASS_EXCEPTION(WideBVH)
+
+		// Four children tested at once. Their boxes are stored in 8 bits per plane, as
+		// steps of a power of two scale from the corner of the node, rounded outwards,
+		// so the whole node fits in a cache line. Leaf children (count > 0) point to the
+		// first of their primitives in the index list, inner ones to their node
+		struct alignas(64) Node {
+			glm::vec3 origin;
+			std::int8_t exponent[3];
+			std::uint8_t childCount;
+			std::uint8_t min[3][4], max[3][4];
+			std::uint32_t child[4];
+			std::uint8_t count[4];
+		};
+
+		static constexpr std::uint32_t cWidth = 4;
+		static constexpr std::uint32_t cMaxLeafSize = 0xFF;
+	private:
+		// Nodes and indices of a tree built in memory, rather than mapped from a file
+		struct Storage {
+			std::vector<Node> nodes;
+			std::vector<std::uint32_t> indices;
+		};
+#pragma endregion
+
+#pragma region //Constructors & Destructors
+	public:
+		WideBVH() noexcept;
+#pragma endregion
+
+#pragma region //Methods
+		void Build(const BVH& bvh);
+		void Save(const std::string& path, const std::uint64_t key) const;
+		DONTDISCARD bool Load(const std::string& path, const std::uint64_t key, const std::uint32_t primitiveCount);
+		template<bool AnyHit = false, typename Test>
+		DONTDISCARD inline bool Intersect(const glm::dvec3& origin, const glm::dvec3& direction, double& tMax, Test&& test) const noexcept;
+		DONTDISCARD inline const Node* GetNodes() const noexcept;
+		DONTDISCARD inline std::uint32_t GetNodeCount() const noexcept;
+		DONTDISCARD inline const std::uint32_t* GetIndices() const noexcept;
+		DONTDISCARD inline std::uint32_t GetIndexCount() const noexcept;
+		DONTDISCARD inline AABB GetBounds() const noexcept;
+	private:
+		static std::uint32_t Collapse(std::vector<Node>& nodes, const BVH& bvh, const std::uint32_t node);
+		static std::uint32_t SplitLeaf(std::vector<Node>& nodes, const std::uint32_t first, const std::uint32_t count, const AABB& box);
+		static std::uint32_t AddNode(std::vector<Node>& nodes, const AABB* boxes, const std::uint32_t childCount);
+		DONTDISCARD bool IsValid(const std::uint32_t primitiveCount) const noexcept;
+		DONTDISCARD static inline __m128 Dequantize(const std::uint8_t* planes, const float origin, const std::int8_t exponent) noexcept;
+#pragma endregion
+
+#pragma region //Members
+		// Whatever the nodes and indices live in, be it a Storage or a mapped file
+		std::shared_ptr<const void> mData;
+		const Node* mNodes;
+		const std::uint32_t* mIndices;
+		std::uint32_t mNodeCount, mIndexCount;
+		AABB mBounds;
+#pragma endregion
+	};
+
+	// ------------------------------------------------------------------------
+	/*! Intersect
+	*
+	*   Walks the nodes the ray goes through like BVH::Intersect does, with the
+	*	slab tests of the four children of a node done together. Children are
+	*	visited nearest first, and skipped once the closest hit so far is nearer
+	*/ // ---------------------------------------------------------------------
+	template<bool AnyHit, typename Test>
+	bool WideBVH::Intersect(const glm::dvec3& origin, const glm::dvec3& direction, double& tMax, Test&& test) const noexcept {
+		//If there is nothing built, there is nothing to hit
+		if (!mNodeCount) return false;
+
+		struct Entry {
+			std::uint32_t child, count;
+			float t;
+		};
+
+		const glm::vec3 inverse = BVH::GetInverse(direction);
+		const __m128 rayOrigin[3] = { _mm_set1_ps(static_cast<float>(origin.x)), _mm_set1_ps(static_cast<float>(origin.y)),
+			_mm_set1_ps(static_cast<float>(origin.z)) };
+		const __m128 rayInverse[3] = { _mm_set1_ps(inverse.x), _mm_set1_ps(inverse.y), _mm_set1_ps(inverse.z) };
+		Entry stack[256];
+		std::uint32_t stackSize = 1;
+		bool hit = false;
+
+		stack[0] = { 0, 0, 0.f };
+
+		while (stackSize) {
+			const Entry entry = stack[--stackSize];
+
+			//If a closer hit was found since the entry was pushed, it is hidden behind it
+			if (entry.t > tMax) continue;
+
+			if (entry.count) {
+				for (std::uint32_t i = 0; i < entry.count; i++)
+					if (test(mIndices[entry.child + i], tMax)) {
+						if constexpr (AnyHit) return true;
+						hit = true;
+					}
+
+				continue;
+			}
+
+			const Node& node = mNodes[entry.child];
+			__m128 tEnter = _mm_setzero_ps(), tExit = _mm_set1_ps(BVH::GetLimit(tMax));
+
+			for (int axis = 0; axis < 3; axis++) {
+				const __m128 t1 = _mm_mul_ps(_mm_sub_ps(Dequantize(node.min[axis], node.origin[axis], node.exponent[axis]), rayOrigin[axis]), rayInverse[axis]);
+				const __m128 t2 = _mm_mul_ps(_mm_sub_ps(Dequantize(node.max[axis], node.origin[axis], node.exponent[axis]), rayOrigin[axis]), rayInverse[axis]);
+
+				tEnter = _mm_max_ps(tEnter, _mm_min_ps(t1, t2));
+				tExit = _mm_min_ps(tExit, _mm_max_ps(t1, t2));
+			}
+
+			const int mask = _mm_movemask_ps(_mm_cmple_ps(tEnter, tExit)) & ((1 << node.childCount) - 1);
+			alignas(16) float distances[4];
+			Entry hits[cWidth];
+			std::uint32_t hitCount = 0;
+
+			_mm_store_ps(distances, tEnter);
+
+			// Sort the children the ray goes through, nearest last so it is popped first
+			for (std::uint32_t i = 0; i < node.childCount; i++) {
+				if (!(mask & (1 << i))) continue;
+
+				std::uint32_t j = hitCount++;
+
+				for (; j && hits[j - 1].t < distances[i]; j--) hits[j] = hits[j - 1];
+				hits[j] = { node.child[i], node.count[i], distances[i] };
+			}
+
+			for (std::uint32_t i = 0; i < hitCount; i++) stack[stackSize++] = hits[i];
+		}
+
+		return hit;
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Dequantize
+	*
+	*   Returns the positions of a plane of the four children, from their steps
+	*	away from the corner of the node. The scale is built straight from its
+	*	exponent bits
+	*/ // ---------------------------------------------------------------------
+	__m128 WideBVH::Dequantize(const std::uint8_t* planes, const float origin, const std::int8_t exponent) noexcept {
+		const std::uint32_t bits = static_cast<std::uint32_t>(exponent + 127) << 23;
+		float scale;
+		int packed;
+
+		std::memcpy(&scale, &bits, sizeof(scale));
+		std::memcpy(&packed, planes, sizeof(packed));
+
+		const __m128i bytes = _mm_cvtsi32_si128(packed);
+		const __m128i words = _mm_unpacklo_epi8(bytes, _mm_setzero_si128());
+		const __m128 steps = _mm_cvtepi32_ps(_mm_unpacklo_epi16(words, _mm_setzero_si128()));
+
+		return _mm_add_ps(_mm_set1_ps(origin), _mm_mul_ps(steps, _mm_set1_ps(scale)));
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Get Nodes
+	*
+	*   Returns the nodes of the tree, the root being the first one
+	*/ // ---------------------------------------------------------------------
+	const WideBVH::Node* WideBVH::GetNodes() const noexcept {
+		return mNodes;
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Get Node Count
+	*
+	*   Returns how many nodes the tree has
+	*/ // ---------------------------------------------------------------------
+	std::uint32_t WideBVH::GetNodeCount() const noexcept {
+		return mNodeCount;
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Get Indices
+	*
+	*   Returns the primitive indices, in the order the leaves refer to them
+	*/ // ---------------------------------------------------------------------
+	const std::uint32_t* WideBVH::GetIndices() const noexcept {
+		return mIndices;
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Get Index Count
+	*
+	*   Returns how many primitive indices the leaves refer to
+	*/ // ---------------------------------------------------------------------
+	std::uint32_t WideBVH::GetIndexCount() const noexcept {
+		return mIndexCount;
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Get Bounds
+	*
+	*   Returns the box around every primitive in the tree
+	*/ // ---------------------------------------------------------------------
+	AABB WideBVH::GetBounds() const noexcept {
+		return mBounds;
+	}
+}
+
+#endif
@@ -0,0 +1,386 @@
+//
+//	Layers.cpp
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 08/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#include "Layers.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace Upscaling {
+	namespace Layers {
+		namespace {
+			// ------------------------------------------------------------------------
+			/*! Pad
+			*
+			*   Returns the input over the padded window, zeroing whatever lies outside
+			*	of the image, so convolutions run over contiguous rows. Inputs which
+			*	were already written padded are used as they are
+			*/ // ---------------------------------------------------------------------
+			const Tensor& Pad(const Tensor& input, const Region& pad, Tensor& padded) {
+				const Region& in = input.GetRegion();
+				const int cx0 = std::max(pad.x, in.x), cx1 = std::min(pad.x + pad.width, in.x + in.width);
+
+				if (in.x == pad.x && in.y == pad.y && in.width == pad.width && in.height == pad.height)
+					return input;
+
+				padded.Resize(input.GetChannels(), pad);
+
+				for (std::size_t c = 0; c < input.GetChannels(); c++) {
+					float* dst = padded.Channel(c);
+					const float* src = input.Channel(c);
+
+					for (int y = 0; y < pad.height; y++) {
+						float* row = dst + static_cast<std::size_t>(y) * pad.width;
+						const int iy = pad.y + y - in.y;
+
+						std::fill(row, row + pad.width, 0.f);
+						if (iy >= 0 && iy < in.height && cx1 > cx0)
+							std::memcpy(row + (cx0 - pad.x), src + static_cast<std::size_t>(iy) * in.width + (cx0 - in.x),
+								(cx1 - cx0) * sizeof(float));
+					}
+				}
+
+				return padded;
+			}
+
+			// ------------------------------------------------------------------------
+			/*! Apply Epilogue
+			*
+			*   Runs the epilogue over a freshly convolved row, which starts at image
+			*	pixel (x, y)
+			*/ // ---------------------------------------------------------------------
+			void ApplyEpilogue(const Epilogue& epilogue, float* dst, const std::size_t channelStride,
+				const std::size_t channels, const int x, const int y, const int width) noexcept {
+				for (std::size_t c = 0; c < channels; c++) {
+					float* d = dst + c * channelStride;
+
+					if (epilogue.skip) {
+						const Region& in = epilogue.skip->GetRegion();
+						const float* s = epilogue.skip->Channel(c) + static_cast<std::size_t>(y - in.y) * in.width + (x - in.x);
+
+						for (int i = 0; i < width; i++) d[i] += s[i];
+					}
+
+					if (epilogue.activation) epilogue.activation->Apply(d, width);
+				}
+			}
+		}
+
+		// ------------------------------------------------------------------------
+		/*! Custom Constructor
+		*
+		*   Builds a square convolution from PyTorch [out, in, k, k] weights
+		*/ // ---------------------------------------------------------------------
+		Conv2D::Conv2D(const WeightTensor& weight, const WeightTensor& bias) :
+			mInChannels{ weight.shape[1] }, mOutChannels{ weight.shape[0] },
+			mKernel{ static_cast<int>(weight.shape[2]) }, mWeights{ weight.data }, mBias{ bias.data } {}
+
+		// ------------------------------------------------------------------------
+		/*! Fold Batch Norm
+		*
+		*   Merges the inference BN that follows the convolution into its weights
+		*/ // ---------------------------------------------------------------------
+		void Conv2D::FoldBatchNorm(const BatchNorm& norm) noexcept {
+			const std::size_t taps = mInChannels * mKernel * mKernel;
+
+			for (std::size_t o = 0; o < mOutChannels; o++) {
+				const float scale = norm.GetScale()[o];
+
+				for (std::size_t i = 0; i < taps; i++) mWeights[o * taps + i] *= scale;
+				mBias[o] = mBias[o] * scale + norm.GetShift()[o];
+			}
+		}
+
+		// ------------------------------------------------------------------------
+		/*! Output Region
+		*
+		*   Returns the part of the input window whose outputs are fully known.
+		*	Edges lying on the image border keep their size, as the network zero
+		*	pads there; inner edges lose the kernel radius
+		*/ // ---------------------------------------------------------------------
+		Region Conv2D::OutputRegion(const Region& input, const int radius, const Extent& image) noexcept {
+			const int x0 = input.x ? input.x + radius : 0;
+			const int y0 = input.y ? input.y + radius : 0;
+			const int x1 = input.x + input.width == image.width ? image.width : input.x + input.width - radius;
+			const int y1 = input.y + input.height == image.height ? image.height : input.y + input.height - radius;
+
+			return { x0, y0, std::max(x1 - x0, 0), std::max(y1 - y0, 0) };
+		}
+
+		// ------------------------------------------------------------------------
+		/*! Convolve Row
+		*
+		*   Computes one output row for every output channel. rows[ky] points to
+		*	the first input channel of the padded row under kernel row ky
+		*/ // ---------------------------------------------------------------------
+		void Conv2D::ConvolveRow(const float* const* rows, const std::size_t rowChannelStride, float* dst,
+			const std::size_t dstChannelStride, const int width) const noexcept {
+			const std::size_t taps = mInChannels * mKernel * mKernel;
+			std::size_t o = 0;
+
+			// Four output channels at a time, so every input load feeds four accumulators
+			for (; o + 4 <= mOutChannels; o += 4) {
+				float* d0 = dst + o * dstChannelStride;
+				float* d1 = d0 + dstChannelStride;
+				float* d2 = d1 + dstChannelStride;
+				float* d3 = d2 + dstChannelStride;
+
+				std::fill(d0, d0 + width, mBias[o]);
+				std::fill(d1, d1 + width, mBias[o + 1]);
+				std::fill(d2, d2 + width, mBias[o + 2]);
+				std::fill(d3, d3 + width, mBias[o + 3]);
+
+				for (std::size_t i = 0; i < mInChannels; i++) {
+					const float* kernel = mWeights.data() + o * taps + i * mKernel * mKernel;
+
+					for (int ky = 0; ky < mKernel; ky++) {
+						const float* s = rows[ky] + i * rowChannelStride;
+
+						for (int kx = 0; kx < mKernel; kx++) {
+							const int tap = ky * mKernel + kx;
+							const float w0 = kernel[tap], w1 = kernel[taps + tap];
+							const float w2 = kernel[2 * taps + tap], w3 = kernel[3 * taps + tap];
+
+							for (int x = 0; x < width; x++) {
+								const float v = s[x + kx];
+
+								d0[x] += w0 * v;
+								d1[x] += w1 * v;
+								d2[x] += w2 * v;
+								d3[x] += w3 * v;
+							}
+						}
+					}
+				}
+			}
+
+			// Whatever channels are left, such as the three of the last layer
+			for (; o < mOutChannels; o++) {
+				float* d = dst + o * dstChannelStride;
+				std::fill(d, d + width, mBias[o]);
+
+				for (std::size_t i = 0; i < mInChannels; i++) {
+					const float* kernel = mWeights.data() + o * taps + i * mKernel * mKernel;
+
+					for (int ky = 0; ky < mKernel; ky++) {
+						const float* s = rows[ky] + i * rowChannelStride;
+
+						for (int kx = 0; kx < mKernel; kx++) {
+							const float w = kernel[ky * mKernel + kx];
+
+							for (int x = 0; x < width; x++) d[x] += w * s[x + kx];
+						}
+					}
+				}
+			}
+		}
+
+		// ------------------------------------------------------------------------
+		/*! Forward
+		*
+		*   Convolves the input window one row at a time, running the epilogue on
+		*	each row as soon as it is done
+		*/ // ---------------------------------------------------------------------
+		void Conv2D::Forward(const Tensor& input, Tensor& output, const Extent& image, Tensor& padded,
+			const Epilogue& epilogue) const {
+			const int radius = GetRadius();
+			const Region out = OutputRegion(input.GetRegion(), radius, image);
+			const Region pad{ out.x - radius, out.y - radius, out.width + 2 * radius, out.height + 2 * radius };
+			std::vector<const float*> rows(mKernel);
+
+			const Tensor& source = Pad(input, pad, padded);
+			output.Resize(mOutChannels, out);
+
+			for (int y = 0; y < out.height; y++) {
+				float* dst = output.Channel(0) + static_cast<std::size_t>(y) * out.width;
+
+				for (int ky = 0; ky < mKernel; ky++)
+					rows[ky] = source.Channel(0) + static_cast<std::size_t>(y + ky) * pad.width;
+
+				ConvolveRow(rows.data(), source.GetPlaneSize(), dst, output.GetPlaneSize(), out.width);
+				ApplyEpilogue(epilogue, dst, output.GetPlaneSize(), mOutChannels, out.x, out.y + y, out.width);
+			}
+		}
+
+		// ------------------------------------------------------------------------
+		/*! Forward Shuffle
+		*
+		*   Convolves the input window and stores each row straight into its place
+		*	in the (C, H * r, W * r) layout of nn.PixelShuffle. The epilogue runs
+		*	on the low res row, before it is scattered. The output is grown by a
+		*	zeroed margin on the image borders, so a following convolution of that
+		*	radius can read it without padding it again
+		*/ // ---------------------------------------------------------------------
+		void Conv2D::ForwardShuffle(const Tensor& input, Tensor& output, const Extent& image, Tensor& padded,
+			std::vector<float>& line, const int factor, const int margin, const Epilogue& epilogue) const {
+			const int radius = GetRadius();
+			const Region out = OutputRegion(input.GetRegion(), radius, image);
+			const Region pad{ out.x - radius, out.y - radius, out.width + 2 * radius, out.height + 2 * radius };
+			const Region shuffled{ out.x * factor, out.y * factor, out.width * factor, out.height * factor };
+			const std::size_t channels = mOutChannels / (factor * factor);
+			std::vector<const float*> rows(mKernel);
+
+			// Only the edges lying on the image border get the margin
+			const int x0 = shuffled.x ? shuffled.x : -margin, y0 = shuffled.y ? shuffled.y : -margin;
+			const int x1 = shuffled.x + shuffled.width == image.width * factor ? image.width * factor + margin : shuffled.x + shuffled.width;
+			const int y1 = shuffled.y + shuffled.height == image.height * factor ? image.height * factor + margin : shuffled.y + shuffled.height;
+			const Region stored{ x0, y0, x1 - x0, y1 - y0 };
+
+			const Tensor& source = Pad(input, pad, padded);
+			output.Resize(channels, stored);
+			line.resize(mOutChannels * out.width);
+
+			// Zero the margin, the rest is written exactly once below
+			for (std::size_t c = 0; c < channels; c++)
+				for (int y = 0; y < stored.height; y++) {
+					float* row = output.Channel(c) + static_cast<std::size_t>(y) * stored.width;
+					const int sy = stored.y + y;
+
+					if (sy < shuffled.y || sy >= shuffled.y + shuffled.height)
+						std::fill(row, row + stored.width, 0.f);
+					else {
+						std::fill(row, row + (shuffled.x - stored.x), 0.f);
+						std::fill(row + (shuffled.x + shuffled.width - stored.x), row + stored.width, 0.f);
+					}
+				}
+
+			for (int y = 0; y < out.height; y++) {
+				for (int ky = 0; ky < mKernel; ky++)
+					rows[ky] = source.Channel(0) + static_cast<std::size_t>(y + ky) * pad.width;
+
+				ConvolveRow(rows.data(), source.GetPlaneSize(), line.data(), out.width, out.width);
+				ApplyEpilogue(epilogue, line.data(), out.width, mOutChannels, out.x, out.y + y, out.width);
+
+				// Channel c * r^2 + i * r + j lands on sub-pixel (j, i) of channel c
+				for (std::size_t c = 0; c < channels; c++)
+					for (int i = 0; i < factor; i++) {
+						float* dst = output.Channel(c) + static_cast<std::size_t>((out.y + y) * factor + i - stored.y) * stored.width
+							+ (shuffled.x - stored.x);
+
+						for (int j = 0; j < factor; j++) {
+							const float* src = line.data() + (c * factor * factor + i * factor + j) * out.width;
+
+							for (int x = 0; x < out.width; x++) dst[x * factor + j] = src[x];
+						}
+					}
+			}
+		}
+
+		// ------------------------------------------------------------------------
+		/*! Custom Constructor
+		*
+		*   Precomputes the per channel affine transform of an inference BN
+		*/ // ---------------------------------------------------------------------
+		BatchNorm::BatchNorm(const WeightTensor& weight, const WeightTensor& bias,
+			const WeightTensor& mean, const WeightTensor& variance) :
+			mScale(weight.data.size()), mShift(weight.data.size()) {
+			for (std::size_t c = 0; c < mScale.size(); c++) {
+				mScale[c] = weight.data[c] / std::sqrt(variance.data[c] + 1e-5f);
+				mShift[c] = bias.data[c] - mean.data[c] * mScale[c];
+			}
+		}
+
+		// ------------------------------------------------------------------------
+		/*! Custom Constructor
+		*
+		*   Builds a PReLU with a single shared slope
+		*/ // ---------------------------------------------------------------------
+		PReLU::PReLU(const WeightTensor& weight) noexcept :
+			mSlope{ weight.data[0] } {}
+
+		// ------------------------------------------------------------------------
+		/*! Apply
+		*
+		*   Applies the activation in place
+		*/ // ---------------------------------------------------------------------
+		void PReLU::Apply(float* data, const std::size_t count) const noexcept {
+			for (std::size_t i = 0; i < count; i++)
+				data[i] = data[i] > 0.f ? data[i] : data[i] * mSlope;
+		}
+
+		// ------------------------------------------------------------------------
+		/*! Custom Constructor
+		*
+		*   Builds conv -> BN -> PReLU -> conv -> BN -> add, folding both BNs into
+		*	their convolutions
+		*/ // ---------------------------------------------------------------------
+		ResidualBlock::ResidualBlock(const Conv2D& conv1, const BatchNorm& bn1, const PReLU& prelu,
+			const Conv2D& conv2, const BatchNorm& bn2) :
+			mConv1{ conv1 }, mPReLU{ prelu }, mConv2{ conv2 } {
+			mConv1.FoldBatchNorm(bn1);
+			mConv2.FoldBatchNorm(bn2);
+		}
+
+		// ------------------------------------------------------------------------
+		/*! Forward
+		*
+		*   Runs the whole block in a single sweep down the window. The rows of the
+		*	intermediate activation live in a small ring of lines, which the second
+		*	convolution consumes as soon as enough of them are ready, so the
+		*	intermediate never leaves the cache
+		*/ // ---------------------------------------------------------------------
+		void ResidualBlock::Forward(const Tensor& input, Tensor& output, const Extent& image, Tensor& padded,
+			std::vector<float>& lines) const {
+			const int r1 = mConv1.GetRadius(), r2 = mConv2.GetRadius();
+			const int k1 = 2 * r1 + 1, k2 = 2 * r2 + 1;
+			const Region mid = Conv2D::OutputRegion(input.GetRegion(), r1, image);
+			const Region out = Conv2D::OutputRegion(mid, r2, image);
+			const Region pad1{ mid.x - r1, mid.y - r1, mid.width + 2 * r1, mid.height + 2 * r1 };
+			const Region pad2{ out.x - r2, out.y - r2, out.width + 2 * r2, out.height + 2 * r2 };
+			const std::size_t channels = mConv1.GetOutChannels();
+			const std::size_t lineSize = channels * pad2.width;
+			const Epilogue activation{ nullptr, &mPReLU }, skip{ &input, nullptr };
+			std::vector<const float*> rows1(k1), rows2(k2);
+
+			const Tensor& source = Pad(input, pad1, padded);
+			output.Resize(mConv2.GetOutChannels(), out);
+			lines.resize(lineSize * k2);
+
+			// Every line holds all channels of one padded row; columns outside of the image stay zero
+			const auto line = [&](const int row) { return lines.data() + static_cast<std::size_t>(row % k2) * lineSize; };
+
+			for (int y = 0, ready = 0; y < out.height; y++) {
+				// Produce the intermediate rows the second convolution is missing
+				for (; ready < y + k2; ready++) {
+					float* dst = line(ready);
+					const int iy = pad2.y + ready;
+
+					std::fill(dst, dst + lineSize, 0.f);
+					if (iy < 0 || iy >= image.height) continue;
+
+					for (int ky = 0; ky < k1; ky++)
+						rows1[ky] = source.Channel(0) + static_cast<std::size_t>(iy - mid.y + ky) * pad1.width;
+
+					dst += mid.x - pad2.x;
+					mConv1.ConvolveRow(rows1.data(), source.GetPlaneSize(), dst, pad2.width, mid.width);
+					ApplyEpilogue(activation, dst, pad2.width, channels, mid.x, iy, mid.width);
+				}
+
+				float* dst = output.Channel(0) + static_cast<std::size_t>(y) * out.width;
+
+				for (int ky = 0; ky < k2; ky++) rows2[ky] = line(y + ky);
+
+				mConv2.ConvolveRow(rows2.data(), pad2.width, dst, output.GetPlaneSize(), out.width);
+				ApplyEpilogue(skip, dst, output.GetPlaneSize(), output.GetChannels(), out.x, out.y + y, out.width);
+			}
+		}
+
+		// ------------------------------------------------------------------------
+		/*! Tanh
+		*
+		*   Applies the hyperbolic tangent in place
+		*/ // ---------------------------------------------------------------------
+		void Tanh(Tensor& tensor) noexcept {
+			float* data = tensor.Channel(0);
+			const std::size_t count = tensor.GetChannels() * tensor.GetPlaneSize();
+
+			for (std::size_t i = 0; i < count; i++)
+				data[i] = std::tanh(data[i]);
+		}
+	}
+}
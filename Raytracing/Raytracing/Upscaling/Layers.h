@@ -0,0 +1,157 @@
+//
+//	Layers.h
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 08/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#ifndef _LAYERS__H_
+#define _LAYERS__H_
+
+#include <vector>
+#include "Tensor.h"
+#include "NetworkWeights.h"
+
+namespace Upscaling {
+	namespace Layers {
+		class BatchNorm {
+		#pragma region //Constructors & Destructors
+		public:
+			BatchNorm(const WeightTensor& weight, const WeightTensor& bias,
+				const WeightTensor& mean, const WeightTensor& variance);
+		#pragma endregion
+
+		#pragma region //Methods
+			DONTDISCARD inline const std::vector<float>& GetScale() const noexcept;
+			DONTDISCARD inline const std::vector<float>& GetShift() const noexcept;
+		#pragma endregion
+
+		#pragma region //Members
+		private:
+			std::vector<float> mScale;
+			std::vector<float> mShift;
+		#pragma endregion
+		};
+
+		class PReLU {
+		#pragma region //Constructors & Destructors
+		public:
+			PReLU(const WeightTensor& weight) noexcept;
+		#pragma endregion
+
+		#pragma region //Methods
+			void Apply(float* data, const std::size_t count) const noexcept;
+		#pragma endregion
+
+		#pragma region //Members
+		private:
+			float mSlope;
+		#pragma endregion
+		};
+
+		// Elementwise work done on each output row of a convolution while it is still in cache
+		struct Epilogue {
+			const Tensor* skip = nullptr;
+			const PReLU* activation = nullptr;
+		};
+
+		class Conv2D {
+		#pragma region //Constructors & Destructors
+		public:
+			Conv2D(const WeightTensor& weight, const WeightTensor& bias);
+		#pragma endregion
+
+		#pragma region //Methods
+			void FoldBatchNorm(const BatchNorm& norm) noexcept;
+			void Forward(const Tensor& input, Tensor& output, const Extent& image, Tensor& padded,
+				const Epilogue& epilogue = {}) const;
+			void ForwardShuffle(const Tensor& input, Tensor& output, const Extent& image, Tensor& padded,
+				std::vector<float>& line, const int factor, const int margin, const Epilogue& epilogue = {}) const;
+			void ConvolveRow(const float* const* rows, const std::size_t rowChannelStride, float* dst,
+				const std::size_t dstChannelStride, const int width) const noexcept;
+			DONTDISCARD inline int GetRadius() const noexcept;
+			DONTDISCARD inline std::size_t GetOutChannels() const noexcept;
+			DONTDISCARD static Region OutputRegion(const Region& input, const int radius, const Extent& image) noexcept;
+		#pragma endregion
+
+		#pragma region //Members
+		private:
+			std::size_t mInChannels, mOutChannels;
+			int mKernel;
+			std::vector<float> mWeights;
+			std::vector<float> mBias;
+		#pragma endregion
+		};
+
+		class ResidualBlock {
+		#pragma region //Constructors & Destructors
+		public:
+			ResidualBlock(const Conv2D& conv1, const BatchNorm& bn1, const PReLU& prelu,
+				const Conv2D& conv2, const BatchNorm& bn2);
+		#pragma endregion
+
+		#pragma region //Methods
+			void Forward(const Tensor& input, Tensor& output, const Extent& image, Tensor& padded,
+				std::vector<float>& lines) const;
+			DONTDISCARD inline int GetRadius() const noexcept;
+		#pragma endregion
+
+		#pragma region //Members
+		private:
+			Conv2D mConv1;
+			PReLU mPReLU;
+			Conv2D mConv2;
+		#pragma endregion
+		};
+
+		void Tanh(Tensor& tensor) noexcept;
+
+		// ------------------------------------------------------------------------
+		/*! Get Scale
+		*
+		*   Returns the per channel factor of the normalization
+		*/ // ---------------------------------------------------------------------
+		const std::vector<float>& BatchNorm::GetScale() const noexcept {
+			return mScale;
+		}
+
+		// ------------------------------------------------------------------------
+		/*! Get Shift
+		*
+		*   Returns the per channel offset of the normalization
+		*/ // ---------------------------------------------------------------------
+		const std::vector<float>& BatchNorm::GetShift() const noexcept {
+			return mShift;
+		}
+
+		// ------------------------------------------------------------------------
+		/*! Get Radius
+		*
+		*   Returns how many pixels the kernel reaches around its center
+		*/ // ---------------------------------------------------------------------
+		int Conv2D::GetRadius() const noexcept {
+			return mKernel / 2;
+		}
+
+		// ------------------------------------------------------------------------
+		/*! Get Out Channels
+		*
+		*   Returns the number of channels produced by the convolution
+		*/ // ---------------------------------------------------------------------
+		std::size_t Conv2D::GetOutChannels() const noexcept {
+			return mOutChannels;
+		}
+
+		// ------------------------------------------------------------------------
+		/*! Get Radius
+		*
+		*   Returns how many pixels the whole block reaches around its center
+		*/ // ---------------------------------------------------------------------
+		int ResidualBlock::GetRadius() const noexcept {
+			return mConv1.GetRadius() + mConv2.GetRadius();
+		}
+	}
+}
+
+#endif
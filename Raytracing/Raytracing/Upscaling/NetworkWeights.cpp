@@ -0,0 +1,115 @@
+//
+//	NetworkWeights.cpp
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 08/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#include "NetworkWeights.h"
+#include <fstream>
+#include <cstdint>
+#include <cstring>
+
+namespace Upscaling {
+	namespace {
+		constexpr char cMagic[4] = { 'S', 'R', 'W', 'T' };
+		constexpr std::uint32_t cVersion = 1;
+
+		// ------------------------------------------------------------------------
+		/*! Read U32
+		*
+		*   Reads a little endian 32 bit unsigned integer from the stream
+		*/ // ---------------------------------------------------------------------
+		std::uint32_t ReadU32(std::istream& stream) {
+			std::uint32_t value = 0;
+			stream.read(reinterpret_cast<char*>(&value), sizeof(value));
+			return value;
+		}
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Custom Constructor
+	*
+	*   Loads the weights written by DLSS/export_weights.py
+	*/ // ---------------------------------------------------------------------
+	NetworkWeights::NetworkWeights(const std::string& path) {
+		std::ifstream file(path, std::ios::binary);
+
+		//If we can't open the file, there is nothing to load
+		if (!file) throw NetworkWeightsException("Failed to open network weights file");
+
+		char magic[4];
+		file.read(magic, sizeof(magic));
+		if (!file || std::memcmp(magic, cMagic, sizeof(magic)) || ReadU32(file) != cVersion)
+			throw NetworkWeightsException("Invalid network weights file");
+
+		const std::uint32_t count = ReadU32(file);
+
+		// Read every named tensor
+		for (std::uint32_t i = 0; i < count; i++) {
+			std::string name(ReadU32(file), '\0');
+			file.read(name.data(), name.size());
+
+			WeightTensor tensor;
+			std::size_t elements = 1;
+			tensor.shape.resize(ReadU32(file));
+
+			for (std::size_t& dim : tensor.shape) {
+				dim = ReadU32(file);
+				elements *= dim;
+			}
+
+			tensor.data.resize(elements);
+			file.read(reinterpret_cast<char*>(tensor.data.data()), elements * sizeof(float));
+
+			if (!file) throw NetworkWeightsException("Truncated network weights file");
+			mTensors.emplace(std::move(name), std::move(tensor));
+		}
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Contains
+	*
+	*   Returns whether a parameter with the given name was exported
+	*/ // ---------------------------------------------------------------------
+	bool NetworkWeights::Contains(const std::string& name) const noexcept {
+		return mTensors.find(name) != mTensors.end();
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Get
+	*
+	*   Returns the parameter with the given name
+	*/ // ---------------------------------------------------------------------
+	const WeightTensor& NetworkWeights::Get(const std::string& name) const {
+		const auto it = mTensors.find(name);
+
+		//If the parameter does not exist, the file does not match the network
+		if (it == mTensors.end()) throw NetworkWeightsException("Missing network parameter");
+
+		return it->second;
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Count
+	*
+	*   Returns the number of consecutive submodules "prefix.0.", "prefix.1.", ...
+	*/ // ---------------------------------------------------------------------
+	std::size_t NetworkWeights::Count(const std::string& prefix) const noexcept {
+		std::size_t count = 0;
+
+		for (;; count++) {
+			const std::string module = prefix + "." + std::to_string(count) + ".";
+			bool found = false;
+
+			for (const auto& tensor : mTensors)
+				if (!tensor.first.compare(0, module.size(), module)) {
+					found = true;
+					break;
+				}
+
+			if (!found) return count;
+		}
+	}
+}
@@ -0,0 +1,47 @@
+//
+//	NetworkWeights.h
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 08/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#ifndef _NETWORK_WEIGHTS__H_
+#define _NETWORK_WEIGHTS__H_
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "../CommonDefines.h"
+
+namespace Upscaling {
+	// A named parameter of the exported network, in PyTorch memory order
+	struct WeightTensor {
+		std::vector<std::size_t> shape;
+		std::vector<float> data;
+	};
+
+	class NetworkWeights {
+	#pragma region //Declarations
+		CLASS_EXCEPTION(NetworkWeights)
+	#pragma endregion
+
+	#pragma region //Constructors & Destructors
+	public:
+		NetworkWeights(const std::string& path);
+	#pragma endregion
+
+	#pragma region //Methods
+		DONTDISCARD bool Contains(const std::string& name) const noexcept;
+		DONTDISCARD const WeightTensor& Get(const std::string& name) const;
+		DONTDISCARD std::size_t Count(const std::string& prefix) const noexcept;
+	#pragma endregion
+
+	#pragma region //Members
+	private:
+		std::unordered_map<std::string, WeightTensor> mTensors;
+	#pragma endregion
+	};
+}
+
+#endif
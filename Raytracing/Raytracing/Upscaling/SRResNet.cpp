@@ -0,0 +1,115 @@
+//
+//	SRResNet.cpp
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 08/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#include "SRResNet.h"
+#include <cmath>
+#include <string>
+
+namespace Upscaling {
+	namespace {
+		// ------------------------------------------------------------------------
+		/*! Make Conv
+		*
+		*   Builds the convolution stored under a module name
+		*/ // ---------------------------------------------------------------------
+		Layers::Conv2D MakeConv(const NetworkWeights& weights, const std::string& module) {
+			return Layers::Conv2D(weights.Get(module + ".weight"), weights.Get(module + ".bias"));
+		}
+
+		// ------------------------------------------------------------------------
+		/*! Make Batch Norm
+		*
+		*   Builds the batch normalization stored under a module name
+		*/ // ---------------------------------------------------------------------
+		Layers::BatchNorm MakeBatchNorm(const NetworkWeights& weights, const std::string& module) {
+			return Layers::BatchNorm(weights.Get(module + ".weight"), weights.Get(module + ".bias"),
+				weights.Get(module + ".running_mean"), weights.Get(module + ".running_var"));
+		}
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Custom Constructor
+	*
+	*   Builds the network described in DLSS/models.py from its exported weights
+	*/ // ---------------------------------------------------------------------
+	SRResNet::SRResNet(const NetworkWeights& weights) :
+		mConv1{ MakeConv(weights, "conv_block1.conv_block.0") },
+		mPReLU1{ weights.Get("conv_block1.conv_block.1.weight") },
+		mConv2{ MakeConv(weights, "conv_block2.conv_block.0") },
+		mConv3{ MakeConv(weights, "conv_block3.conv_block.0") } {
+		const std::size_t blocks = weights.Count("residual_blocks");
+		const std::size_t shuffles = weights.Count("pixel_suffle_blocks");
+
+		for (std::size_t i = 0; i < blocks; i++) {
+			const std::string block = "residual_blocks." + std::to_string(i);
+			mResidualBlocks.emplace_back(MakeConv(weights, block + ".conv_block1.conv_block.0"),
+										 MakeBatchNorm(weights, block + ".conv_block1.conv_block.1"),
+										 Layers::PReLU(weights.Get(block + ".conv_block1.conv_block.2.weight")),
+										 MakeConv(weights, block + ".conv_block2.conv_block.0"),
+										 MakeBatchNorm(weights, block + ".conv_block2.conv_block.1"));
+		}
+
+		mConv2.FoldBatchNorm(MakeBatchNorm(weights, "conv_block2.conv_block.1"));
+
+		for (std::size_t i = 0; i < shuffles; i++) {
+			const std::string block = "pixel_suffle_blocks." + std::to_string(i);
+			mPixelShuffleBlocks.push_back({ MakeConv(weights, block + ".conv"),
+											Layers::PReLU(weights.Get(block + ".prelu.weight")) });
+		}
+
+		mScalingFactor = 1 << shuffles;
+
+		// Add up how far every layer reaches, converting the high res layers back to low res pixels
+		double halo = mConv1.GetRadius() + mConv2.GetRadius();
+
+		for (const Layers::ResidualBlock& block : mResidualBlocks)
+			halo += block.GetRadius();
+
+		for (std::size_t i = 0; i < mPixelShuffleBlocks.size(); i++)
+			halo += mPixelShuffleBlocks[i].conv.GetRadius() / static_cast<double>(1 << i);
+
+		halo += mConv3.GetRadius() / static_cast<double>(mScalingFactor);
+		mHalo = static_cast<int>(std::ceil(halo));
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Forward
+	*
+	*   Runs the network over a window of the image. The input holds imagenet
+	*	normalized colors, the output holds colors in [-1, 1] and covers at least
+	*	the input window shrunk by the halo (scaled to high res)
+	*/ // ---------------------------------------------------------------------
+	void SRResNet::Forward(const Tensor& input, Tensor& output, const Extent& image, Scratch& scratch) const {
+		Extent extent = image;
+
+		mConv1.Forward(input, scratch.x, extent, scratch.padded, { nullptr, &mPReLU1 });
+		scratch.residual = scratch.x;
+
+		// Residual blocks, each fused into a single sweep
+		for (const Layers::ResidualBlock& block : mResidualBlocks) {
+			block.Forward(scratch.x, scratch.u, extent, scratch.padded, scratch.lines);
+			std::swap(scratch.x, scratch.u);
+		}
+
+		mConv2.Forward(scratch.x, scratch.t, extent, scratch.padded, { &scratch.residual, nullptr });
+		std::swap(scratch.x, scratch.t);
+
+		// Upscale by two on each sub-pixel block, leaving room for the padding of the next convolution
+		for (std::size_t i = 0; i < mPixelShuffleBlocks.size(); i++) {
+			const PixelShuffleBlock& block = mPixelShuffleBlocks[i];
+			const int margin = i + 1 < mPixelShuffleBlocks.size() ? mPixelShuffleBlocks[i + 1].conv.GetRadius() : mConv3.GetRadius();
+
+			block.conv.ForwardShuffle(scratch.x, scratch.t, extent, scratch.padded, scratch.lines, 2, margin, { nullptr, &block.prelu });
+			std::swap(scratch.x, scratch.t);
+			extent = { extent.width * 2, extent.height * 2 };
+		}
+
+		mConv3.Forward(scratch.x, output, extent, scratch.padded);
+		Layers::Tanh(output);
+	}
+}
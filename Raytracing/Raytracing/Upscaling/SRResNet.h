@@ -0,0 +1,75 @@
+//
+//	SRResNet.h
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 08/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#ifndef _SRRESNET__H_
+#define _SRRESNET__H_
+
+#include <vector>
+#include "Layers.h"
+
+namespace Upscaling {
+	class SRResNet {
+	#pragma region //Declarations
+	public:
+		// Per thread activations, reused from one tile to the next
+		struct Scratch {
+			Tensor x, t, u, residual, padded;
+			std::vector<float> lines;
+		};
+
+	private:
+		struct PixelShuffleBlock {
+			Layers::Conv2D conv;
+			Layers::PReLU prelu;
+		};
+	#pragma endregion
+
+	#pragma region //Constructors & Destructors
+	public:
+		SRResNet(const NetworkWeights& weights);
+	#pragma endregion
+
+	#pragma region //Methods
+		void Forward(const Tensor& input, Tensor& output, const Extent& image, Scratch& scratch) const;
+		DONTDISCARD inline int GetScalingFactor() const noexcept;
+		DONTDISCARD inline int GetHalo() const noexcept;
+	#pragma endregion
+
+	#pragma region //Members
+	private:
+		Layers::Conv2D mConv1;
+		Layers::PReLU mPReLU1;
+		std::vector<Layers::ResidualBlock> mResidualBlocks;
+		Layers::Conv2D mConv2;
+		std::vector<PixelShuffleBlock> mPixelShuffleBlocks;
+		Layers::Conv2D mConv3;
+		int mScalingFactor;
+		int mHalo;
+	#pragma endregion
+	};
+
+	// ------------------------------------------------------------------------
+	/*! Get Scaling Factor
+	*
+	*   Returns how many times the network enlarges each dimension
+	*/ // ---------------------------------------------------------------------
+	int SRResNet::GetScalingFactor() const noexcept {
+		return mScalingFactor;
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Get Halo
+	*
+	*   Returns the receptive field radius of the network, in low res pixels
+	*/ // ---------------------------------------------------------------------
+	int SRResNet::GetHalo() const noexcept {
+		return mHalo;
+	}
+}
+
+#endif
@@ -0,0 +1,41 @@
+//
+//	Tensor.cpp
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 08/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#include "Tensor.h"
+
+namespace Upscaling {
+	// ------------------------------------------------------------------------
+	/*! Default Constructor
+	*
+	*   Constructs an empty Tensor
+	*/ // ---------------------------------------------------------------------
+	Tensor::Tensor() noexcept :
+		mChannels{ 0 }, mRegion{ 0, 0, 0, 0 } {}
+
+	// ------------------------------------------------------------------------
+	/*! Custom Constructor
+	*
+	*   Constructs a Tensor with a number of channels covering a region
+	*/ // ---------------------------------------------------------------------
+	Tensor::Tensor(const std::size_t channels, const Region& region) :
+		mChannels{ 0 }, mRegion{ 0, 0, 0, 0 } {
+		Resize(channels, region);
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Resize
+	*
+	*   Reshapes the Tensor. The storage is only grown, never shrunk, so
+	*	scratch tensors reused across tiles stop allocating after the first one
+	*/ // ---------------------------------------------------------------------
+	void Tensor::Resize(const std::size_t channels, const Region& region) {
+		mChannels = channels;
+		mRegion = region;
+		mData.resize(mChannels * GetPlaneSize());
+	}
+}
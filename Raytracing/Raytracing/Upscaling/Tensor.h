@@ -0,0 +1,97 @@
+//
+//	Tensor.h
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 08/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#ifndef _TENSOR__H_
+#define _TENSOR__H_
+
+#include <vector>
+#include <cstddef>
+#include "../CommonDefines.h"
+
+namespace Upscaling {
+	// Window of an activation map, in pixel coordinates of the image at the tensor's scale
+	struct Region {
+		int x, y, width, height;
+	};
+
+	// Size of the whole image at a given scale
+	struct Extent {
+		int width, height;
+	};
+
+	class Tensor {
+	#pragma region //Constructors & Destructors
+	public:
+		Tensor() noexcept;
+		Tensor(const std::size_t channels, const Region& region);
+	#pragma endregion
+
+	#pragma region //Methods
+		void Resize(const std::size_t channels, const Region& region);
+		DONTDISCARD inline float* Channel(const std::size_t c) noexcept;
+		DONTDISCARD inline const float* Channel(const std::size_t c) const noexcept;
+		DONTDISCARD inline std::size_t GetChannels() const noexcept;
+		DONTDISCARD inline const Region& GetRegion() const noexcept;
+		DONTDISCARD inline std::size_t GetPlaneSize() const noexcept;
+	#pragma endregion
+
+	#pragma region //Members
+	private:
+		std::size_t mChannels;
+		Region mRegion;
+		std::vector<float> mData;
+	#pragma endregion
+	};
+
+	// ------------------------------------------------------------------------
+	/*! Channel
+	*
+	*   Returns the first element of a channel plane (row-major, region sized)
+	*/ // ---------------------------------------------------------------------
+	float* Tensor::Channel(const std::size_t c) noexcept {
+		return mData.data() + c * GetPlaneSize();
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Channel
+	*
+	*   Returns the first element of a channel plane (row-major, region sized)
+	*/ // ---------------------------------------------------------------------
+	const float* Tensor::Channel(const std::size_t c) const noexcept {
+		return mData.data() + c * GetPlaneSize();
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Get Channels
+	*
+	*   Returns the number of channels of the Tensor
+	*/ // ---------------------------------------------------------------------
+	std::size_t Tensor::GetChannels() const noexcept {
+		return mChannels;
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Get Region
+	*
+	*   Returns the image window covered by the Tensor
+	*/ // ---------------------------------------------------------------------
+	const Region& Tensor::GetRegion() const noexcept {
+		return mRegion;
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Get Plane Size
+	*
+	*   Returns the number of elements of a single channel
+	*/ // ---------------------------------------------------------------------
+	std::size_t Tensor::GetPlaneSize() const noexcept {
+		return static_cast<std::size_t>(mRegion.width) * static_cast<std::size_t>(mRegion.height);
+	}
+}
+
+#endif
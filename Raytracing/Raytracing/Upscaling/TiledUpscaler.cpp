@@ -0,0 +1,133 @@
+//
+//	TiledUpscaler.cpp
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 08/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#include "TiledUpscaler.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace Upscaling {
+	namespace {
+		constexpr float cImagenetMean[3] = { 0.485f, 0.456f, 0.406f };
+		constexpr float cImagenetStd[3] = { 0.229f, 0.224f, 0.225f };
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Custom Constructor
+	*
+	*   Loads the network. A thread count of 0 uses every hardware thread
+	*/ // ---------------------------------------------------------------------
+	TiledUpscaler::TiledUpscaler(const std::string& weightsPath, const int tileSize, const unsigned threadCount) :
+		mNetwork{ NetworkWeights(weightsPath) }, mTileSize{ std::max(tileSize, 1) },
+		mThreadCount{ threadCount ? threadCount : std::max(std::thread::hardware_concurrency(), 1u) } {}
+
+	// ------------------------------------------------------------------------
+	/*! Get Tile Count
+	*
+	*   Returns the number of tiles the low res image is split into
+	*/ // ---------------------------------------------------------------------
+	std::size_t TiledUpscaler::GetTileCount(const Core::FrameBuffer& lowRes) const noexcept {
+		const std::size_t tilesX = (lowRes.GetWidth() + mTileSize - 1) / mTileSize;
+		const std::size_t tilesY = (lowRes.GetHeight() + mTileSize - 1) / mTileSize;
+
+		return tilesX * tilesY;
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Get Tile Region
+	*
+	*   Returns the low res pixels covered by a tile, in row major tile order
+	*/ // ---------------------------------------------------------------------
+	Region TiledUpscaler::GetTileRegion(const Core::FrameBuffer& lowRes, const std::size_t tile) const noexcept {
+		const int width = static_cast<int>(lowRes.GetWidth());
+		const int height = static_cast<int>(lowRes.GetHeight());
+		const int tilesX = (width + mTileSize - 1) / mTileSize;
+		const int x = static_cast<int>(tile % tilesX) * mTileSize;
+		const int y = static_cast<int>(tile / tilesX) * mTileSize;
+
+		return { x, y, std::min(mTileSize, width - x), std::min(mTileSize, height - y) };
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Upscale
+	*
+	*   Upscales the whole image, distributing tiles among the worker threads
+	*/ // ---------------------------------------------------------------------
+	void TiledUpscaler::Upscale(const Core::FrameBuffer& lowRes, Core::FrameBuffer& highRes) const {
+		const std::size_t tileCount = GetTileCount(lowRes);
+		std::atomic<std::size_t> nextTile{ 0 };
+		std::vector<std::thread> workers;
+
+		// Every worker keeps grabbing the next unprocessed tile
+		const auto work = [&]() {
+			for (std::size_t tile = nextTile++; tile < tileCount; tile = nextTile++)
+				UpscaleTile(lowRes, highRes, tile);
+		};
+
+		for (unsigned i = 1; i < std::min<std::size_t>(mThreadCount, tileCount); i++)
+			workers.emplace_back(work);
+
+		work();
+		for (std::thread& worker : workers) worker.join();
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Upscale Tile
+	*
+	*   Upscales a single tile, reading its halo from the low res image and
+	*	writing the result straight into the high res image. Tiles never write
+	*	to the same pixels, so any number of threads may call this at once, as
+	*	soon as the low res pixels under the tile and its halo are rendered
+	*/ // ---------------------------------------------------------------------
+	void TiledUpscaler::UpscaleTile(const Core::FrameBuffer& lowRes, Core::FrameBuffer& highRes, const std::size_t tile) const {
+		thread_local SRResNet::Scratch scratch;
+		thread_local Tensor input, output;
+
+		const Extent image{ static_cast<int>(lowRes.GetWidth()), static_cast<int>(lowRes.GetHeight()) };
+		const Region region = GetTileRegion(lowRes, tile);
+		const int halo = mNetwork.GetHalo();
+		const int scale = mNetwork.GetScalingFactor();
+
+		// Grow the tile by the halo, without leaving the image
+		const int x0 = std::max(region.x - halo, 0), y0 = std::max(region.y - halo, 0);
+		const int x1 = std::min(region.x + region.width + halo, image.width);
+		const int y1 = std::min(region.y + region.height + halo, image.height);
+
+		input.Resize(3, { x0, y0, x1 - x0, y1 - y0 });
+
+		// Convert the low res colors into imagenet normalized planes
+		for (int y = y0; y < y1; y++)
+			for (int x = x0; x < x1; x++) {
+				const sf::Color color = lowRes.GetColor(x, y);
+				const std::size_t index = static_cast<std::size_t>(y - y0) * (x1 - x0) + (x - x0);
+
+				input.Channel(0)[index] = (color.r / 255.f - cImagenetMean[0]) / cImagenetStd[0];
+				input.Channel(1)[index] = (color.g / 255.f - cImagenetMean[1]) / cImagenetStd[1];
+				input.Channel(2)[index] = (color.b / 255.f - cImagenetMean[2]) / cImagenetStd[2];
+			}
+
+		mNetwork.Forward(input, output, image, scratch);
+
+		// Store the tile itself, dropping the high res halo
+		const Region& out = output.GetRegion();
+		const int hx1 = std::min((region.x + region.width) * scale, static_cast<int>(highRes.GetWidth()));
+		const int hy1 = std::min((region.y + region.height) * scale, static_cast<int>(highRes.GetHeight()));
+
+		for (int y = region.y * scale; y < hy1; y++)
+			for (int x = region.x * scale; x < hx1; x++) {
+				const std::size_t index = static_cast<std::size_t>(y - out.y) * out.width + (x - out.x);
+				const auto toByte = [](const float v) {
+					return static_cast<sf::Uint8>(std::clamp((v + 1.f) * 127.5f, 0.f, 255.f));
+				};
+
+				highRes.SetColor(x, y, sf::Color(toByte(output.Channel(0)[index]), toByte(output.Channel(1)[index]),
+					toByte(output.Channel(2)[index]), 255));
+			}
+	}
+}
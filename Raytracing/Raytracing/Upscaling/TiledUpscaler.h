@@ -0,0 +1,59 @@
+//
+//	TiledUpscaler.h
+//	DLSS-Raytracing
+//
+//	Created by Diego Revilla on 08/07/24
+//	Copyright  2024. All Rights reserved
+//
+
+#ifndef _TILED_UPSCALER__H_
+#define _TILED_UPSCALER__H_
+
+#include <string>
+#include "SRResNet.h"
+#include "../Core/FrameBuffer.h"
+
+namespace Upscaling {
+	class TiledUpscaler {
+	#pragma region //Constructors & Destructors
+	public:
+		TiledUpscaler(const std::string& weightsPath, const int tileSize = 64, const unsigned threadCount = 0);
+	#pragma endregion
+
+	#pragma region //Methods
+		void Upscale(const Core::FrameBuffer& lowRes, Core::FrameBuffer& highRes) const;
+		void UpscaleTile(const Core::FrameBuffer& lowRes, Core::FrameBuffer& highRes, const std::size_t tile) const;
+		DONTDISCARD std::size_t GetTileCount(const Core::FrameBuffer& lowRes) const noexcept;
+		DONTDISCARD Region GetTileRegion(const Core::FrameBuffer& lowRes, const std::size_t tile) const noexcept;
+		DONTDISCARD inline int GetScalingFactor() const noexcept;
+		DONTDISCARD inline int GetHalo() const noexcept;
+	#pragma endregion
+
+	#pragma region //Members
+	private:
+		SRResNet mNetwork;
+		int mTileSize;
+		unsigned mThreadCount;
+	#pragma endregion
+	};
+
+	// ------------------------------------------------------------------------
+	/*! Get Scaling Factor
+	*
+	*   Returns how many times the upscaler enlarges each dimension
+	*/ // ---------------------------------------------------------------------
+	int TiledUpscaler::GetScalingFactor() const noexcept {
+		return mNetwork.GetScalingFactor();
+	}
+
+	// ------------------------------------------------------------------------
+	/*! Get Halo
+	*
+	*   Returns how many low res pixels a tile reads around itself
+	*/ // ---------------------------------------------------------------------
+	int TiledUpscaler::GetHalo() const noexcept {
+		return mNetwork.GetHalo();
+	}
+}
+
+#endif